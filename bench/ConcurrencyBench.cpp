@@ -0,0 +1,194 @@
+// Handing fixes from the parsing thread to other threads: loads from a
+// TinyGPSFixPublisher against a mutex-guarded copy, by 1, 2, 4, ... reader
+// threads while a writer thread publishes as fast as it can, every fix
+// queued through a TinyGPSFixRing to a consumer draining batches, and
+// threads reading one idle parser through its const and non-const getters.
+
+#include "TinyGPS++.h"
+#include "TinyGPSFixPublisher.h"
+#include "TinyGPSFixRing.h"
+
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+TinyGPSFix makeFix(uint32_t i) {
+  TinyGPSFix fix = {};
+  fix.latitude = 48117300000LL + i;
+  fix.longitude = 11516666667LL + i;
+  fix.time = i;
+  fix.valid = fix.updated = 0xFF;
+  fix.commitTime = i;
+  return fix;
+}
+
+// A fix behind a mutex, the obvious alternative
+class MutexFix {
+public:
+  void publish(const TinyGPSFix &f) {
+    std::lock_guard<std::mutex> lock(mutex);
+    fix = f;
+  }
+  TinyGPSFix load() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return fix;
+  }
+
+private:
+  std::mutex mutex;
+  TinyGPSFix fix = {};
+};
+
+// Publishes to target on its own thread from start() to stop()
+template <class Target> class Writer {
+public:
+  void start(Target &target) {
+    running = true;
+    thread = std::thread([this, &target] {
+      for (uint32_t i = 0; running.load(std::memory_order_relaxed); ++i)
+        target.publish(makeFix(i));
+    });
+  }
+  void stop() {
+    running = false;
+    thread.join();
+  }
+
+private:
+  std::atomic<bool> running;
+  std::thread thread;
+};
+
+// The fix of the parsing thread, published to the benchmark threads
+template <class Target> void loadFixes(benchmark::State &state) {
+  static Target target;
+  static Writer<Target> writer;
+  if (state.thread_index() == 0)
+    writer.start(target);
+  int64_t sum = 0;
+  for (auto _ : state) {
+    TinyGPSFix fix = target.load();
+    sum += fix.latitude;
+  }
+  benchmark::DoNotOptimize(sum);
+  if (state.thread_index() == 0)
+    writer.stop();
+  state.SetItemsProcessed(state.iterations());
+}
+
+void BM_SeqlockLoad(benchmark::State &state) {
+  loadFixes<TinyGPSFixPublisher>(state);
+}
+BENCHMARK(BM_SeqlockLoad)->ThreadRange(1, 4)->UseRealTime();
+
+void BM_MutexLoad(benchmark::State &state) { loadFixes<MutexFix>(state); }
+BENCHMARK(BM_MutexLoad)->ThreadRange(1, 4)->UseRealTime();
+
+// One publish, uncontended: the cost the parsing thread pays per sentence
+void BM_SeqlockPublish(benchmark::State &state) {
+  TinyGPSFixPublisher publisher;
+  uint32_t i = 0;
+  for (auto _ : state)
+    publisher.publish(makeFix(i++));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SeqlockPublish);
+
+typedef TinyGPSFixRing<1024> Ring;
+
+// A producer thread pushes fixes as fast as it can while the benchmark
+// thread drains them 64 at a time, with the policy state.range(0). With
+// DROP_OLDEST, fixes the consumer falls behind on are dropped, so fewer
+// are delivered than pushed.
+void BM_RingTransfer(benchmark::State &state) {
+  const uint32_t perIteration = 1 << 16;
+  Ring ring((Ring::Policy)state.range(0));
+  TinyGPSFix batch[64];
+  int64_t received = 0, sum = 0;
+  for (auto _ : state) {
+    std::thread producer([&ring] {
+      for (uint32_t i = 0; i < perIteration; ++i)
+        ring.push(makeFix(i));
+      ring.push(makeFix(perIteration)); // end marker
+    });
+    for (bool done = false; !done;) {
+      size_t n = ring.pop(batch, 64);
+      for (size_t i = 0; i < n; ++i) {
+        sum += batch[i].latitude;
+        done |= batch[i].time == perIteration;
+      }
+      received += n;
+      if (n == 0)
+        std::this_thread::yield();
+    }
+    producer.join();
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations() * (perIteration + 1));
+  state.counters["delivered"] =
+      benchmark::Counter((double)received, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_RingTransfer)
+    ->ArgName("policy")
+    ->Arg(Ring::BLOCK)
+    ->Arg(Ring::DROP_OLDEST)
+    ->UseRealTime();
+
+// Push and pop on one thread: the cost per fix without cross-core traffic
+void BM_RingPushPop(benchmark::State &state) {
+  Ring ring;
+  TinyGPSFix batch[64];
+  uint32_t i = 0;
+  for (auto _ : state) {
+    for (int j = 0; j < 64; ++j)
+      ring.push(makeFix(i++));
+    benchmark::DoNotOptimize(ring.pop(batch, 64));
+  }
+  state.SetItemsProcessed(state.iterations() * 64);
+}
+BENCHMARK(BM_RingPushPop);
+
+// A parser that has decoded one fix and is no longer parsing
+const TinyGPSPlus &sharedParser() {
+  static TinyGPSPlus gps = [] {
+    const char fix[] =
+        "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A"
+        "\r\n$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,"
+        "*47\r\n";
+    TinyGPSPlus parser;
+    parser.encode(fix, sizeof(fix) - 1);
+    return parser;
+  }();
+  return gps;
+}
+
+// Every thread reads the same parser through the non-const getters, each
+// read clearing an updated flag and so writing to the parser's lines. The
+// threads all store false, which is what this measures.
+void BM_SharedReadMutating(benchmark::State &state) {
+  static TinyGPSPlus *gps = const_cast<TinyGPSPlus *>(&sharedParser());
+  double sum = 0;
+  for (auto _ : state)
+    sum += gps->location.lat() + gps->location.lng() + gps->speed.knots() +
+           gps->altitude.meters() + gps->time.value();
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SharedReadMutating)->ThreadRange(1, 4)->UseRealTime();
+
+// The same reads through the const getters, which only read
+void BM_SharedReadConst(benchmark::State &state) {
+  static const TinyGPSPlus &gps = sharedParser();
+  double sum = 0;
+  for (auto _ : state)
+    sum += gps.location.lat() + gps.location.lng() + gps.speed.knots() +
+           gps.altitude.meters() + gps.time.value();
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SharedReadConst)->ThreadRange(1, 4)->UseRealTime();
+
+} // namespace
@@ -0,0 +1,605 @@
+// Tests that the bulk encode(const char*, size_t) leaves exactly the state
+// encode(char) does, on clean streams and on streams with corrupt checksums,
+// truncated sentences and overlong fields, whole or cut into chunks.
+
+#include "NMEAGenerator.h"
+#include "TinyGPS++.h"
+#include "TinyGPSSatellites.h"
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+
+namespace {
+
+// A parser with the satellite table and custom fields attached, so every
+// decode path is exercised
+struct Parser {
+  TinyGPSPlus gps;
+  TinyGPSSatellites sats;
+  TinyGPSCustom gsv[19], gsa[17], rmc[3], gga[5];
+
+  Parser() {
+    sats.begin(gps);
+    for (int i = 0; i < 19; ++i)
+      gsv[i].begin(gps, "GPGSV", i + 1);
+    for (int i = 0; i < 17; ++i)
+      gsa[i].begin(gps, "GNGSA", i + 1);
+    for (int i = 0; i < 3; ++i)
+      rmc[i].begin(gps, "GPRMC", 10 + i);
+    for (int i = 0; i < 5; ++i)
+      gga[i].begin(gps, "GPGGA", 10 + i);
+  }
+};
+
+template <typename T>
+void put(std::ostream &out, const char *name, const T &v) {
+  out << ' ' << name << '=' << v.isValid() << v.isUpdated() << ':'
+      << v.value();
+}
+
+void put(std::ostream &out, const char *name, const RawDegrees &deg) {
+  out << ' ' << name << '=' << deg.negative << deg.deg << '.'
+      << deg.billionths;
+}
+
+// Every field a sketch can read, read through the const getters so reading
+// does not clear updated
+std::string snapshot(const Parser &p) {
+  const TinyGPSPlus &gps = p.gps;
+  std::ostringstream out;
+  out << "chars=" << gps.charsProcessed() << " fix=" << gps.sentencesWithFix()
+      << " failed=" << gps.failedChecksum()
+      << " passed=" << gps.passedChecksum();
+  out << " location=" << gps.location.isValid() << gps.location.isUpdated();
+  put(out, "lat", gps.location.rawLat());
+  put(out, "lng", gps.location.rawLng());
+  put(out, "date", gps.date);
+  put(out, "time", gps.time);
+  put(out, "speed", gps.speed);
+  put(out, "course", gps.course);
+  put(out, "altitude", gps.altitude);
+  put(out, "satellites", gps.satellites);
+  put(out, "hdop", gps.hdop);
+  put(out, "fixMode", gps.fixMode);
+  put(out, "pdop", gps.pdop);
+  put(out, "vdop", gps.vdop);
+  out << " timeZone=" << gps.timeZone.isValid() << gps.timeZone.isUpdated()
+      << ':' << gps.timeZone.offset();
+  out << " errorStats=" << gps.errorStats.isValid()
+      << gps.errorStats.isUpdated();
+  for (int f = 0; f < TinyGPSErrorStats::FIELDS; ++f)
+    out << ':' << gps.errorStats.value((TinyGPSErrorStats::Field)f);
+#if !_GPS_NO_RTCM
+  out << " rtcm=" << gps.rtcm.passedFrames() << '/'
+      << gps.rtcm.failedFrames() << '/' << gps.rtcm.inFrame();
+#endif
+
+  const TinyGPSFix fix = gps.fix();
+  out << "\nfix=" << fix.latitude << ',' << fix.longitude << ',' << fix.date
+      << ',' << fix.time << ',' << fix.speed << ',' << fix.course << ','
+      << fix.altitude << ',' << fix.hdop << ',' << fix.satellites << ','
+      << (int)fix.valid << ',' << (int)fix.updated << ',' << fix.commitTime;
+
+  out << "\nsats=" << p.sats.isValid() << p.sats.isUpdated() << ':'
+      << (int)p.sats.count() << '/' << (int)p.sats.usedCount();
+  for (uint8_t i = 0; i < p.sats.count(); ++i)
+    out << ' ' << p.sats.prn(i) << ',' << (int)p.sats.elevation(i) << ','
+        << p.sats.azimuth(i) << ',' << (int)p.sats.snr(i) << ','
+        << (int)p.sats.constellation(i) << ',' << p.sats.isUsed(i);
+
+  const TinyGPSCustom *groups[] = {p.gsv, p.gsa, p.rmc, p.gga};
+  const int sizes[] = {19, 17, 3, 5};
+  for (int g = 0; g < 4; ++g) {
+    out << '\n';
+    for (int i = 0; i < sizes[g]; ++i)
+      out << '[' << groups[g][i].isValid() << groups[g][i].isUpdated()
+          << groups[g][i].value() << ']';
+  }
+  return out.str();
+}
+
+// Feeds stream to one parser a character at a time and to another in
+// chunks of at most chunk characters, comparing after every chunk
+void expectSameState(const std::string &stream, size_t chunk) {
+  TinyGPSClock::hold(1000);
+  Parser bytewise, bulk;
+  uint32_t validBytewise = 0, validBulk = 0;
+  bench::Random rng(7);
+  for (size_t i = 0; i < stream.size();) {
+    size_t n = chunk ? 1 + rng.below((uint32_t)chunk) : stream.size();
+    if (n > stream.size() - i)
+      n = stream.size() - i;
+    for (size_t k = 0; k < n; ++k)
+      validBytewise += bytewise.gps.encode(stream[i + k]);
+    validBulk += bulk.gps.encode(stream.data() + i, n);
+    i += n;
+    ASSERT_EQ(snapshot(bytewise), snapshot(bulk)) << "after byte " << i;
+  }
+  EXPECT_EQ(validBytewise, validBulk);
+  TinyGPSClock::release();
+}
+
+std::string noisyStream(uint32_t seed, double corrupt, double truncate,
+                        double overlong) {
+  bench::NMEAGenerator::Options options;
+  options.seed = seed;
+  options.sentences = ~0u;
+  options.talkers = {"GP", "GL", "GA"};
+  options.lineEnding = bench::NMEAGenerator::MIXED;
+  options.corruptChecksum = corrupt;
+  options.truncate = truncate;
+  options.overlongField = overlong;
+  return bench::NMEAGenerator(options).seconds(60);
+}
+
+TEST(EncodeTest, CleanStream) {
+  std::string stream = noisyStream(1, 0, 0, 0);
+  expectSameState(stream, 0);
+  expectSameState(stream, 97);
+}
+
+TEST(EncodeTest, CorruptChecksums) {
+  std::string stream = noisyStream(2, 0.3, 0, 0);
+  expectSameState(stream, 0);
+  expectSameState(stream, 97);
+}
+
+TEST(EncodeTest, TruncatedSentences) {
+  std::string stream = noisyStream(3, 0, 0.3, 0);
+  expectSameState(stream, 0);
+  expectSameState(stream, 97);
+}
+
+TEST(EncodeTest, OverlongFields) {
+  std::string stream = noisyStream(4, 0, 0, 0.3);
+  expectSameState(stream, 0);
+  expectSameState(stream, 97);
+}
+
+TEST(EncodeTest, AllNoise) {
+  std::string stream = noisyStream(5, 0.2, 0.2, 0.2);
+  expectSameState(stream, 0);
+  expectSameState(stream, 7);
+  expectSameState(stream, 600);
+}
+
+// A UBX NAV-PVT frame around payload, its checksum corrupted when broken
+std::string navPvtFrame(const unsigned char (&payload)[92], bool broken) {
+  std::string frame("\xB5\x62\x01\x07\x5C\x00", 6);
+  frame.append((const char *)payload, sizeof(payload));
+  uint8_t a = 0, b = 0;
+  for (size_t i = 2; i < frame.size(); ++i) {
+    a += (uint8_t)frame[i];
+    b += a;
+  }
+  frame += (char)a;
+  frame += (char)(broken ? b + 1 : b);
+  return frame;
+}
+
+// A UBX NAV-PVT frame with a random date, its checksum corrupted when
+// broken
+std::string ubxFrame(bench::Random &rng, bool broken) {
+  unsigned char payload[92] = {0};
+  payload[4] = (unsigned char)(2000 + rng.below(30));
+  payload[5] = (unsigned char)((2000 + rng.below(30)) >> 8);
+  payload[6] = (unsigned char)(1 + rng.below(12));
+  payload[7] = (unsigned char)(1 + rng.below(28));
+  payload[11] = 3; // date and time valid
+  payload[20] = 3; // 3D fix
+  payload[21] = 1; // GNSS fix OK
+  payload[23] = (unsigned char)rng.below(20);
+  return navPvtFrame(payload, broken);
+}
+
+// An RTCM3 frame whose payload is made of NMEA delimiters, its CRC
+// corrupted when broken
+std::string rtcmFrame(bench::Random &rng, bool broken) {
+  size_t length = 2 + rng.below(60);
+  std::string frame(length + 6, '\0');
+  frame[0] = (char)0xD3;
+  frame[2] = (char)length;
+  frame[3] = (char)(1005 >> 4);
+  frame[4] = (char)((1005 & 0xF) << 4);
+  for (size_t i = 5; i < length + 3; ++i)
+    frame[i] = "$,*\r\nG"[rng.below(6)];
+  uint32_t crc = TinyGPSRTCM::crc24q(0, (const uint8_t *)frame.data(),
+                                     length + 3);
+  frame[length + 3] = (char)(crc >> 16);
+  frame[length + 4] = (char)(crc >> 8);
+  frame[length + 5] = (char)(broken ? crc + 1 : crc);
+  return frame;
+}
+
+// UBX and RTCM frames, whole, broken or cut short, and stray characters
+// with their high bit set, between and inside NMEA sentences
+TEST(EncodeTest, BinaryFramesMixedIn) {
+  std::string text = noisyStream(6, 0.05, 0.05, 0.05);
+  bench::Random rng(6);
+  std::string stream;
+  for (size_t i = 0; i < text.size();) {
+    size_t n = 1 + rng.below(150);
+    stream.append(text, i, n);
+    i += n;
+    std::string frame;
+    switch (rng.below(6)) {
+    case 0:
+      frame = ubxFrame(rng, rng.below(4) == 0);
+      break;
+    case 1:
+      frame = rtcmFrame(rng, rng.below(4) == 0);
+      break;
+    case 2:
+      frame = rng.below(2) ? ubxFrame(rng, false) : rtcmFrame(rng, false);
+      frame.resize(rng.below((uint32_t)frame.size()));
+      break;
+    case 3:
+      frame = "\xB5\xD3\xE9\xFF"[rng.below(4)];
+      break;
+    }
+    stream += frame;
+  }
+  expectSameState(stream, 0);
+  expectSameState(stream, 1);
+  expectSameState(stream, 7);
+  expectSameState(stream, 600);
+}
+
+// A sentence that fails its checksum stages nothing, so a later sentence
+// that leaves those terms empty commits the values committed before it
+TEST(EncodeTest, FailedSentenceStagesNothing) {
+  std::string stream;
+  bench::appendSentence(stream, "GPRMC,123519,A,4807.038,N,01131.000,E,022.4,"
+                                "084.4,230394,003.1,W");
+  stream += "$GPRMC,123520,A,5107.038,S,00131.000,W,010.0,180.0,240394,"
+            "003.1,W*00\r\n";
+  bench::appendSentence(stream, "GPRMC,123521,A,,,,,,,,003.1,W");
+  expectSameState(stream, 0);
+  expectSameState(stream, 9);
+
+  Parser bulk;
+  bulk.gps.encode(stream.data(), stream.size());
+  EXPECT_EQ(1u, bulk.gps.failedChecksum());
+  EXPECT_EQ(2u, bulk.gps.passedChecksum());
+  EXPECT_NEAR(48.1173, bulk.gps.location.lat(), 1e-6);
+  EXPECT_NEAR(11.516667, bulk.gps.location.lng(), 1e-6);
+  EXPECT_EQ(230394u, bulk.gps.date.value());
+  EXPECT_EQ(2240, bulk.gps.speed.value());
+  EXPECT_EQ(12352100u, bulk.gps.time.value());
+}
+
+// A failed sentence between two GSA sentences ends the run of GSA sentences
+// on both paths
+TEST(EncodeTest, FailedSentenceEndsGsaRun) {
+  std::string stream;
+  bench::appendSentence(stream, "GNGSA,A,3,01,02,03,,,,,,,,,,1.5,0.9,1.2,1");
+  stream += "$GPGGA,123520,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,"
+            "*00\r\n";
+  bench::appendSentence(stream, "GNGSA,A,3,65,66,,,,,,,,,,,1.5,0.9,1.2,2");
+  bench::appendSentence(stream,
+                        "GPGSV,1,1,04,01,40,083,46,02,17,308,41,65,07,344,"
+                        "39,66,22,228,45");
+  expectSameState(stream, 0);
+  expectSameState(stream, 5);
+}
+
+// Feeds stream to one parser a character at a time and to another in one
+// call, and runs check on each
+template <typename Check>
+void onBothPaths(const std::string &stream, Check check) {
+  Parser bytewise, bulk;
+  for (size_t i = 0; i < stream.size(); ++i)
+    bytewise.gps.encode(stream[i]);
+  bulk.gps.encode(stream.data(), stream.size());
+  {
+    SCOPED_TRACE("encode(char)");
+    check(bytewise);
+  }
+  {
+    SCOPED_TRACE("encode(const char *, size_t)");
+    check(bulk);
+  }
+}
+
+// GSA commits the fix mode and the three DOPs, and the satellites used go
+// to the table under the system of the NMEA 4.10 system ID in term 18
+TEST(EncodeTest, GsaValues) {
+  std::string stream;
+  bench::appendSentence(stream, "GNGSA,A,3,01,02,03,,,,,,,,,,1.5,0.9,1.2,1");
+  bench::appendSentence(stream, "GNGSA,A,3,65,66,,,,,,,,,,,1.6,1.0,1.3,2");
+  bench::appendSentence(stream, "GNGSA,A,3,05,,,,,,,,,,,,1.7,1.1,1.4,3");
+  onBothPaths(stream, [](Parser &p) {
+    EXPECT_TRUE(p.gps.fixMode.isValid());
+    EXPECT_EQ(3u, p.gps.fixMode.value());
+    EXPECT_EQ(170, p.gps.pdop.value());
+    EXPECT_EQ(110, p.gps.hdop.value());
+    EXPECT_EQ(140, p.gps.vdop.value());
+    EXPECT_DOUBLE_EQ(1.7, p.gps.pdop.pdop());
+    EXPECT_DOUBLE_EQ(1.4, p.gps.vdop.vdop());
+
+    EXPECT_EQ(6, p.sats.usedCount());
+    for (uint16_t prn = 1; prn <= 3; ++prn)
+      EXPECT_TRUE(p.sats.isUsed(TinyGPSSatellites::GPS, prn)) << prn;
+    EXPECT_TRUE(p.sats.isUsed(TinyGPSSatellites::GLONASS, 65));
+    EXPECT_TRUE(p.sats.isUsed(TinyGPSSatellites::GLONASS, 66));
+    EXPECT_TRUE(p.sats.isUsed(TinyGPSSatellites::GALILEO, 5));
+    EXPECT_FALSE(p.sats.isUsed(TinyGPSSatellites::GPS, 5));
+  });
+
+  // A new epoch replaces the set; 2D fix, no system ID
+  bench::appendSentence(stream, "GPGGA,123520,4807.038,N,01131.000,E,1,08,"
+                                "0.9,545.4,M,46.9,M,,");
+  bench::appendSentence(stream, "GPGSA,A,2,07,,,,,,,,,,,,2.5,1.3,2.1");
+  onBothPaths(stream, [](Parser &p) {
+    EXPECT_EQ(2u, p.gps.fixMode.value());
+    EXPECT_EQ(250, p.gps.pdop.value());
+    EXPECT_EQ(130, p.gps.hdop.value());
+    EXPECT_EQ(210, p.gps.vdop.value());
+    EXPECT_EQ(1, p.sats.usedCount());
+    EXPECT_TRUE(p.sats.isUsed(TinyGPSSatellites::GPS, 7));
+  });
+}
+
+// VTG commits course and speed unless its mode says the data is not valid
+TEST(EncodeTest, VtgValues) {
+  std::string stream;
+  bench::appendSentence(stream, "GPVTG,054.7,T,034.4,M,005.5,N,010.2,K,A");
+  onBothPaths(stream, [](Parser &p) {
+    EXPECT_EQ(5470, p.gps.course.value());
+    EXPECT_EQ(550, p.gps.speed.value());
+    EXPECT_DOUBLE_EQ(10.186, p.gps.speed.kmph());
+  });
+
+  // Mode N: not valid
+  bench::appendSentence(stream, "GPVTG,120.0,T,099.7,M,020.0,N,037.0,K,N");
+  onBothPaths(stream, [](Parser &p) {
+    EXPECT_EQ(1u, p.gps.passedChecksum() - p.gps.sentencesWithFix());
+    EXPECT_EQ(5470, p.gps.course.value());
+    EXPECT_EQ(550, p.gps.speed.value());
+  });
+
+  // Before NMEA 2.3 there is no mode
+  bench::appendSentence(stream, "GPVTG,230.5,T,210.2,M,001.5,N,002.8,K");
+  onBothPaths(stream, [](Parser &p) {
+    EXPECT_EQ(23050, p.gps.course.value());
+    EXPECT_EQ(150, p.gps.speed.value());
+  });
+}
+
+// GLL commits the time always and the location when its status is A
+TEST(EncodeTest, GllValues) {
+  std::string stream;
+  bench::appendSentence(stream, "GPGLL,4916.45,N,12311.12,W,225444,A,A");
+  onBothPaths(stream, [](Parser &p) {
+    EXPECT_NEAR(49.274167, p.gps.location.lat(), 1e-6);
+    EXPECT_NEAR(-123.185333, p.gps.location.lng(), 1e-6);
+    EXPECT_EQ(22544400u, p.gps.time.value());
+  });
+
+  bench::appendSentence(stream, "GPGLL,3751.65,S,14507.36,E,225445,V,N");
+  onBothPaths(stream, [](Parser &p) {
+    EXPECT_NEAR(49.274167, p.gps.location.lat(), 1e-6);
+    EXPECT_NEAR(-123.185333, p.gps.location.lng(), 1e-6);
+    EXPECT_EQ(22544500u, p.gps.time.value());
+  });
+}
+
+// ZDA commits the date from its day, month and four-digit year, and the
+// local zone with the sign of its hours
+TEST(EncodeTest, ZdaValues) {
+  std::string stream;
+  bench::appendSentence(stream, "GPZDA,201530.00,04,07,2002,-05,30");
+  onBothPaths(stream, [](Parser &p) {
+    EXPECT_EQ(20153000u, p.gps.time.value());
+    EXPECT_EQ(4, p.gps.date.day());
+    EXPECT_EQ(7, p.gps.date.month());
+    EXPECT_EQ(2002, p.gps.date.year());
+    EXPECT_TRUE(p.gps.timeZone.isValid());
+    EXPECT_EQ(-330, p.gps.timeZone.offset());
+  });
+
+  // -00 is still negative
+  bench::appendSentence(stream, "GPZDA,201531.00,31,12,1999,-00,45");
+  onBothPaths(stream, [](Parser &p) {
+    EXPECT_EQ(31, p.gps.date.day());
+    EXPECT_EQ(12, p.gps.date.month());
+    EXPECT_EQ(1999, p.gps.date.year());
+    EXPECT_EQ(-45, p.gps.timeZone.offset());
+  });
+
+  bench::appendSentence(stream, "GPZDA,201532.00,01,01,2024,09,00");
+  onBothPaths(stream, [](Parser &p) {
+    EXPECT_EQ(2024, p.gps.date.year());
+    EXPECT_EQ(540, p.gps.timeZone.offset());
+  });
+}
+
+// GNS commits like GGA; its mode string has one character per system
+TEST(EncodeTest, GnsValues) {
+  std::string stream;
+  bench::appendSentence(stream, "GNGNS,014035.00,4332.69262,S,17235.48549,E,"
+                                "RR,13,0.9,25.63,11.24,,");
+  onBothPaths(stream, [](Parser &p) {
+    EXPECT_EQ(1403500u, p.gps.time.value());
+    EXPECT_NEAR(-43.544877, p.gps.location.lat(), 1e-6);
+    EXPECT_NEAR(172.591425, p.gps.location.lng(), 1e-6);
+    EXPECT_EQ(13u, p.gps.satellites.value());
+    EXPECT_EQ(90, p.gps.hdop.value());
+    EXPECT_EQ(2563, p.gps.altitude.value());
+  });
+
+  bench::appendSentence(stream, "GNGNS,112257.00,3844.24011,N,00908.43828,W,"
+                                "AN,03,10.5,,,,");
+  onBothPaths(stream, [](Parser &p) {
+    EXPECT_NEAR(38.737335, p.gps.location.lat(), 1e-6);
+    EXPECT_NEAR(-9.140638, p.gps.location.lng(), 1e-6);
+    EXPECT_EQ(3u, p.gps.satellites.value());
+  });
+
+  // No system has a fix: time, satellites and HDOP only
+  bench::appendSentence(stream, "GNGNS,112258.00,0000.00000,N,00000.00000,E,"
+                                "NN,00,99.9,,,,");
+  onBothPaths(stream, [](Parser &p) {
+    EXPECT_EQ(11225800u, p.gps.time.value());
+    EXPECT_NEAR(38.737335, p.gps.location.lat(), 1e-6);
+    EXPECT_EQ(0u, p.gps.satellites.value());
+    EXPECT_EQ(9990, p.gps.hdop.value());
+  });
+}
+
+// GST commits all seven statistics to the millimeter
+TEST(EncodeTest, GstValues) {
+  std::string stream;
+  bench::appendSentence(stream, "GPGST,172814.0,0.006,0.023,0.020,273.6,"
+                                "0.023,0.020,0.031");
+  onBothPaths(stream, [](Parser &p) {
+    const TinyGPSErrorStats &stats = p.gps.errorStats;
+    EXPECT_TRUE(stats.isValid());
+    EXPECT_EQ(6, stats.value(TinyGPSErrorStats::RMS));
+    EXPECT_EQ(23, stats.value(TinyGPSErrorStats::SEMI_MAJOR));
+    EXPECT_EQ(20, stats.value(TinyGPSErrorStats::SEMI_MINOR));
+    EXPECT_EQ(273600, stats.value(TinyGPSErrorStats::ORIENTATION));
+    EXPECT_EQ(23, stats.value(TinyGPSErrorStats::LATITUDE));
+    EXPECT_EQ(20, stats.value(TinyGPSErrorStats::LONGITUDE));
+    EXPECT_EQ(31, stats.value(TinyGPSErrorStats::ALTITUDE));
+    EXPECT_DOUBLE_EQ(0.006, stats.rms());
+    EXPECT_DOUBLE_EQ(273.6, stats.orientation());
+    EXPECT_DOUBLE_EQ(0.031, stats.altitudeError());
+  });
+
+  // Fewer decimals, more decimals than are kept, and an empty field,
+  // which keeps its value
+  bench::appendSentence(stream, "GPGST,172815.0,1.5,12,0.0239,10.25,,"
+                                "0.0001,2.10");
+  onBothPaths(stream, [](Parser &p) {
+    const TinyGPSErrorStats &stats = p.gps.errorStats;
+    EXPECT_EQ(1500, stats.value(TinyGPSErrorStats::RMS));
+    EXPECT_EQ(12000, stats.value(TinyGPSErrorStats::SEMI_MAJOR));
+    EXPECT_EQ(23, stats.value(TinyGPSErrorStats::SEMI_MINOR));
+    EXPECT_EQ(10250, stats.value(TinyGPSErrorStats::ORIENTATION));
+    EXPECT_EQ(23, stats.value(TinyGPSErrorStats::LATITUDE));
+    EXPECT_EQ(0, stats.value(TinyGPSErrorStats::LONGITUDE));
+    EXPECT_EQ(2100, stats.value(TinyGPSErrorStats::ALTITUDE));
+  });
+}
+
+// Stores value little endian at offset of a UBX payload
+void putLE(unsigned char *payload, size_t offset, uint32_t value,
+           size_t size) {
+  for (size_t i = 0; i < size; ++i)
+    payload[offset + i] = (unsigned char)(value >> (8 * i));
+}
+
+// A NAV-PVT frame with every field encode() reads set
+std::string knownNavPvt(uint8_t fixType, uint8_t flags, uint8_t second,
+                        int32_t latitude) {
+  unsigned char payload[92] = {0};
+  putLE(payload, 4, 2024, 2);        // year
+  payload[6] = 3;                    // month
+  payload[7] = 9;                    // day
+  payload[8] = 12;                   // hour
+  payload[9] = 34;                   // minute
+  payload[10] = second;              // second
+  payload[11] = 3;                   // date and time valid
+  putLE(payload, 16, 780000000, 4);  // nano
+  payload[20] = fixType;             // fix type
+  payload[21] = flags;               // GNSS fix OK
+  payload[23] = 17;                  // satellites
+  putLE(payload, 24, 115166667, 4);  // longitude, 1e-7 degrees
+  putLE(payload, 28, (uint32_t)latitude, 4);
+  putLE(payload, 36, 123456, 4);     // height above MSL, mm
+  putLE(payload, 60, 5144, 4);       // ground speed, mm/s
+  putLE(payload, 64, 12345678, 4);   // heading of motion, 1e-5 degrees
+  putLE(payload, 76, 156, 2);        // PDOP
+  return navPvtFrame(payload, false);
+}
+
+// NAV-PVT fields are converted to the units of the NMEA fields, rounded
+TEST(EncodeTest, NavPvtValues) {
+  std::string stream = knownNavPvt(3, 1, 56, -481173000);
+  onBothPaths(stream, [](Parser &p) {
+    EXPECT_EQ(1u, p.gps.passedChecksum());
+    EXPECT_EQ(1u, p.gps.sentencesWithFix());
+    EXPECT_NEAR(-48.1173, p.gps.location.lat(), 1e-7);
+    EXPECT_NEAR(11.5166667, p.gps.location.lng(), 1e-7);
+    EXPECT_EQ(1000, p.gps.speed.value()); // 10.00 knots
+    EXPECT_EQ(12346, p.gps.course.value());
+    EXPECT_EQ(12346, p.gps.altitude.value());
+    EXPECT_EQ(90324u, p.gps.date.value());
+    EXPECT_EQ(2024, p.gps.date.year());
+    EXPECT_EQ(12345678u, p.gps.time.value());
+    EXPECT_EQ(17u, p.gps.satellites.value());
+    EXPECT_EQ(3u, p.gps.fixMode.value());
+    EXPECT_EQ(156, p.gps.pdop.value());
+  });
+
+  // Without a fix, the date, time, satellites and fix mode are committed
+  // and the position is kept
+  stream += knownNavPvt(0, 0, 57, 0);
+  onBothPaths(stream, [](Parser &p) {
+    EXPECT_EQ(2u, p.gps.passedChecksum());
+    EXPECT_EQ(1u, p.gps.sentencesWithFix());
+    EXPECT_NEAR(-48.1173, p.gps.location.lat(), 1e-7);
+    EXPECT_EQ(12345778u, p.gps.time.value());
+    EXPECT_EQ(1u, p.gps.fixMode.value());
+  });
+
+  // A time-only solution flagged GNSS fix OK is no position fix either
+  stream += knownNavPvt(5, 1, 58, 0);
+  onBothPaths(stream, [](Parser &p) {
+    EXPECT_EQ(3u, p.gps.passedChecksum());
+    EXPECT_EQ(1u, p.gps.sentencesWithFix());
+    EXPECT_TRUE(p.gps.date.isValid());
+    EXPECT_EQ(90324u, p.gps.date.value());
+    EXPECT_EQ(12345878u, p.gps.time.value());
+    EXPECT_NEAR(-48.1173, p.gps.location.lat(), 1e-7);
+    EXPECT_EQ(1000, p.gps.speed.value());
+    EXPECT_EQ(1u, p.gps.fixMode.value());
+  });
+}
+
+// Custom fields registered in any order, including names longer than the
+// packed sentence key that share its first eight characters, each receive
+// their own term
+TEST(EncodeTest, CustomFieldsInAnyOrder) {
+  const char *names[] = {"GPGSA", "PUBX", "PSRFTXTA", "PSRFTXTAB",
+                         "PSRFTXTABC", "GNGSA", "GPGGA"};
+  const int nameCount = sizeof(names) / sizeof(names[0]);
+  const int terms = 6;
+  TinyGPSPlus gps;
+  TinyGPSCustom customs[nameCount * terms];
+  bench::Random rng(11);
+  int order[nameCount * terms];
+  for (int i = 0; i < nameCount * terms; ++i)
+    order[i] = i;
+  for (int i = nameCount * terms - 1; i > 0; --i) {
+    int j = (int)rng.below((uint32_t)i + 1);
+    int t = order[i];
+    order[i] = order[j];
+    order[j] = t;
+  }
+  for (int i = 0; i < nameCount * terms; ++i) {
+    int n = order[i] / terms, t = order[i] % terms + 1;
+    customs[order[i]].begin(gps, names[n], t);
+  }
+
+  std::string stream;
+  for (int n = 0; n < nameCount; ++n) {
+    std::string body = names[n];
+    for (int t = 1; t <= terms; ++t)
+      body += "," + std::to_string(n) + "." + std::to_string(t);
+    bench::appendSentence(stream, body);
+  }
+  gps.encode(stream.data(), stream.size());
+
+  for (int n = 0; n < nameCount; ++n)
+    for (int t = 1; t <= terms; ++t) {
+      const TinyGPSCustom &c = customs[n * terms + t - 1];
+      EXPECT_TRUE(c.isValid()) << names[n] << " term " << t;
+      EXPECT_EQ(std::to_string(n) + "." + std::to_string(t), c.value())
+          << names[n] << " term " << t;
+    }
+}
+
+} // namespace
@@ -0,0 +1,148 @@
+// Tests that TinyGPSFixRing hands its consumer whole fixes in the order they
+// were pushed, and under DROP_OLDEST accounts for every fix it discards.
+
+#include "NMEAGenerator.h"
+#include "TinyGPSFixRing.h"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+
+namespace {
+
+// The k-th fix pushed, every field derived from k so the consumer can tell
+// a torn copy from a whole one
+TinyGPSFix numbered(uint32_t k) {
+  TinyGPSFix fix = {};
+  fix.latitude = (int64_t)k * 3;
+  fix.longitude = -(int64_t)k;
+  fix.date = k + 1;
+  fix.time = k;
+  fix.hdop = (int32_t)k;
+  fix.commitTime = k * 7;
+  fix.satellites = (uint16_t)k;
+  return fix;
+}
+
+bool isWhole(const TinyGPSFix &fix) {
+  uint32_t k = fix.time;
+  TinyGPSFix want = numbered(k);
+  return fix.latitude == want.latitude && fix.longitude == want.longitude &&
+         fix.date == want.date && fix.hdop == want.hdop &&
+         fix.commitTime == want.commitTime &&
+         fix.satellites == want.satellites;
+}
+
+// Pushes fixes 1 to total from one thread while this one pops them in
+// batches, checking each batch as it arrives
+template <size_t N>
+void pushAndDrain(TinyGPSFixRing<N> &ring, uint32_t total) {
+  std::thread producer([&] {
+    for (uint32_t k = 1; k <= total; ++k)
+      ring.push(numbered(k));
+  });
+
+  uint64_t delivered = 0, torn = 0, outOfOrder = 0, gaps = 0;
+  uint32_t last = 0;
+  TinyGPSFix batch[32];
+  // The newest fix is never dropped, so the last one pushed always arrives
+  while (last < total) {
+    size_t n = ring.pop(batch, 32);
+    if (n == 0)
+      std::this_thread::yield();
+    for (size_t i = 0; i < n; ++i) {
+      uint32_t k = batch[i].time;
+      if (!isWhole(batch[i]))
+        ++torn;
+      if (k <= last)
+        ++outOfOrder;
+      else if (k != last + 1)
+        ++gaps;
+      last = k;
+      ++delivered;
+    }
+  }
+  producer.join();
+
+  EXPECT_EQ(0u, torn);
+  EXPECT_EQ(0u, outOfOrder);
+  EXPECT_EQ(0u, ring.size());
+  EXPECT_EQ((uint64_t)total, delivered + ring.dropped());
+  if (ring.dropped() == 0) {
+    EXPECT_EQ(0u, gaps);
+  }
+}
+
+TEST(FixRingTest, BlockDeliversEveryFixInOrder) {
+  static TinyGPSFixRing<64> ring;
+  pushAndDrain(ring, 2000000);
+  EXPECT_EQ(0u, ring.dropped());
+}
+
+TEST(FixRingTest, DropOldestCountsEveryDrop) {
+  static TinyGPSFixRing<16> ring(TinyGPSFixRing<16>::DROP_OLDEST);
+  pushAndDrain(ring, 2000000);
+}
+
+TEST(FixRingTest, DropOldestSmallestRing) {
+  static TinyGPSFixRing<2> ring(TinyGPSFixRing<2>::DROP_OLDEST);
+  pushAndDrain(ring, 1000000);
+}
+
+// Without a consumer, a full DROP_OLDEST ring keeps the newest N fixes
+TEST(FixRingTest, DropOldestKeepsNewest) {
+  TinyGPSFixRing<8> ring(TinyGPSFixRing<8>::DROP_OLDEST);
+  for (uint32_t k = 1; k <= 20; ++k)
+    ring.push(numbered(k));
+  EXPECT_EQ(12u, ring.dropped());
+  EXPECT_EQ(8u, ring.size());
+  TinyGPSFix fix;
+  for (uint32_t k = 13; k <= 20; ++k) {
+    ASSERT_TRUE(ring.pop(fix));
+    EXPECT_EQ(k, fix.time);
+  }
+  EXPECT_FALSE(ring.pop(fix));
+}
+
+TEST(FixRingTest, TryPushRefusesWhenFull) {
+  TinyGPSFixRing<4> ring;
+  for (uint32_t k = 1; k <= 4; ++k)
+    EXPECT_TRUE(ring.tryPush(numbered(k)));
+  EXPECT_FALSE(ring.tryPush(numbered(5)));
+  TinyGPSFix fix;
+  ASSERT_TRUE(ring.pop(fix));
+  EXPECT_EQ(1u, fix.time);
+  EXPECT_TRUE(ring.tryPush(numbered(5)));
+  for (uint32_t k = 2; k <= 5; ++k) {
+    ASSERT_TRUE(ring.pop(fix));
+    EXPECT_EQ(k, fix.time);
+  }
+  EXPECT_EQ(0u, ring.dropped());
+}
+
+#if _GPS_MAX_LISTENERS > 0
+// An attached ring queues a fix for each RMC and GGA, not for GSA
+TEST(FixRingTest, AttachedQueuesFixSentences) {
+  TinyGPSPlus gps;
+  TinyGPSFixRing<8> ring;
+  ASSERT_TRUE(ring.attach(gps));
+
+  std::string stream;
+  bench::appendSentence(stream, "GPRMC,123519,A,4807.038,N,01131.000,E,022.4,"
+                                "084.4,230394,003.1,W");
+  bench::appendSentence(stream, "GPGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1");
+  bench::appendSentence(stream, "GPGGA,123520,4807.040,N,01131.000,E,1,08,0.9,"
+                                "545.4,M,46.9,M,,");
+  gps.encode(stream.data(), stream.size());
+
+  TinyGPSFix fix;
+  ASSERT_TRUE(ring.pop(fix));
+  EXPECT_EQ(12351900u, fix.time);
+  ASSERT_TRUE(ring.pop(fix));
+  EXPECT_EQ(12352000u, fix.time);
+  EXPECT_EQ(gps.fix().latitude, fix.latitude);
+  EXPECT_FALSE(ring.pop(fix));
+}
+#endif
+
+} // namespace
@@ -0,0 +1,71 @@
+// Multi-threaded ingest scaling: 10k receiver streams fed through
+// TinyGPSIngest with 1, 2, 4, ... worker threads up to the number of cores.
+// Each iteration submits one 256-byte chunk per stream and drains, so
+// sentences/s against worker count is the scaling curve.
+
+#include "NMEAGenerator.h"
+#include "TinyGPSIngest.h"
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const size_t streamCount = 10000;
+const size_t chunkSize = 256;
+
+const std::string &corpus() {
+  static std::string c;
+  if (c.empty()) {
+    bench::NMEAGenerator::Options options;
+    options.rateHz = 10;
+    options.talkers = {"GP", "GL"};
+    c = bench::NMEAGenerator(options).seconds(600);
+  }
+  return c;
+}
+
+void BM_Ingest(benchmark::State &state) {
+  const std::string &c = corpus();
+  TinyGPSPoolConfig config;
+  TinyGPSPool pool(config, streamCount);
+  TinyGPSIngest ingest(pool, (unsigned)state.range(0));
+
+  std::vector<size_t> offset(streamCount);
+  for (size_t i = 0; i < streamCount; ++i)
+    offset[i] = (i * 7919 * chunkSize) % (c.size() - chunkSize);
+
+  for (auto _ : state) {
+    for (size_t i = 0; i < streamCount; ++i) {
+      if (offset[i] + chunkSize > c.size())
+        offset[i] = 0;
+      ingest.submit(i, c.data() + offset[i], chunkSize);
+      offset[i] += chunkSize;
+    }
+    ingest.drain();
+  }
+
+  state.SetBytesProcessed(state.iterations() * streamCount * chunkSize);
+  state.counters["sentences"] = benchmark::Counter(
+      (double)ingest.sentences(), benchmark::Counter::kIsRate);
+  state.counters["steals"] = (double)ingest.steals();
+}
+
+void workerCounts(benchmark::internal::Benchmark *b) {
+  unsigned cores = std::thread::hardware_concurrency();
+  if (cores == 0)
+    cores = 1;
+  for (unsigned w = 1; w < cores; w *= 2)
+    b->Arg(w);
+  b->Arg(cores);
+}
+
+BENCHMARK(BM_Ingest)
+    ->ArgName("workers")
+    ->Apply(workerCounts)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
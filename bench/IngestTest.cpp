@@ -0,0 +1,128 @@
+// Tests that TinyGPSIngest, parsing many streams on several workers that
+// steal from each other, leaves each stream with the fix a single-threaded
+// TinyGPSPlus commits from the same bytes.
+
+#include "NMEAGenerator.h"
+#include "TinyGPS++.h"
+#include "TinyGPSIngest.h"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::string noisyStream(uint32_t seed, double noise) {
+  bench::NMEAGenerator::Options options;
+  options.seed = seed;
+  options.rateHz = 5;
+  options.sentences = ~0u;
+  options.talkers = {"GP", "GL", "GN"};
+  options.lineEnding = bench::NMEAGenerator::MIXED;
+  options.corruptChecksum = noise;
+  options.truncate = noise;
+  options.overlongField = noise;
+  return bench::NMEAGenerator(options).seconds(20);
+}
+
+// Compares the committed values and valid masks. commitTime and updated
+// depend on when and how often the fix was read, so they are left out.
+void expectSameFix(const TinyGPSFix &want, const TinyGPSFix &got,
+                   size_t stream) {
+  ASSERT_EQ(want.valid, got.valid) << "stream " << stream;
+  EXPECT_EQ(want.latitude, got.latitude) << "stream " << stream;
+  EXPECT_EQ(want.longitude, got.longitude) << "stream " << stream;
+  EXPECT_EQ(want.date, got.date) << "stream " << stream;
+  EXPECT_EQ(want.time, got.time) << "stream " << stream;
+  EXPECT_EQ(want.speed, got.speed) << "stream " << stream;
+  EXPECT_EQ(want.course, got.course) << "stream " << stream;
+  EXPECT_EQ(want.altitude, got.altitude) << "stream " << stream;
+  EXPECT_EQ(want.satellites, got.satellites) << "stream " << stream;
+  EXPECT_EQ(want.hdop, got.hdop) << "stream " << stream;
+}
+
+struct Streams {
+  std::vector<std::string> data;
+  std::vector<size_t> offset;
+
+  explicit Streams(size_t count) : offset(count) {
+    for (size_t i = 0; i < count; ++i)
+      data.push_back(noisyStream(100 + (uint32_t)i, i % 3 * 0.04));
+  }
+
+  // Submits up to rounds random-length chunks of each stream in turn,
+  // streams lo to hi only
+  void submit(TinyGPSIngest &ingest, bench::Random &rng, size_t lo,
+              size_t hi, int rounds) {
+    for (int r = 0; r < rounds; ++r)
+      for (size_t i = lo; i < hi; ++i) {
+        size_t left = data[i].size() - offset[i];
+        size_t n = 1 + rng.below(700);
+        n = n < left ? n : left;
+        if (n != 0)
+          ingest.submit(i, data[i].data() + offset[i], n);
+        offset[i] += n;
+      }
+  }
+
+  void expectSameAsTinyGPSPlus(const TinyGPSPool &pool) {
+    for (size_t i = 0; i < data.size(); ++i) {
+      TinyGPSPlus gps;
+      gps.encode(data[i].data(), offset[i]);
+      expectSameFix(gps.fix(), pool.fix(i), i);
+      EXPECT_EQ(gps.passedChecksum(), pool.passedChecksum(i));
+      EXPECT_EQ(gps.failedChecksum(), pool.failedChecksum(i));
+    }
+  }
+};
+
+TEST(IngestTest, MatchesSequentialParse) {
+  const size_t streamCount = 48;
+  Streams streams(streamCount);
+  TinyGPSPoolConfig config;
+  TinyGPSPool pool(config, streamCount);
+  TinyGPSIngest ingest(pool, 4);
+  bench::Random rng(1);
+
+  // Part of every stream, then the rest, checking after each drain
+  streams.submit(ingest, rng, 0, streamCount, 20);
+  ingest.drain();
+  streams.expectSameAsTinyGPSPlus(pool);
+
+  streams.submit(ingest, rng, 0, streamCount, 1000);
+  ingest.drain();
+  streams.expectSameAsTinyGPSPlus(pool);
+
+  uint64_t passed = 0;
+  for (size_t i = 0; i < streamCount; ++i) {
+    EXPECT_EQ(streams.data[i].size(), streams.offset[i]);
+    passed += pool.passedChecksum(i);
+  }
+  EXPECT_EQ(passed, ingest.sentences());
+}
+
+// Several threads submit, each its own streams, while the workers parse
+TEST(IngestTest, ConcurrentSubmitters) {
+  const size_t streamCount = 32;
+  const size_t submitters = 4;
+  Streams streams(streamCount);
+  TinyGPSPoolConfig config;
+  TinyGPSPool pool(config, streamCount);
+  {
+    TinyGPSIngest ingest(pool, 3);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < submitters; ++t)
+      threads.emplace_back([&, t] {
+        bench::Random rng(10 + (uint32_t)t);
+        size_t share = streamCount / submitters;
+        streams.submit(ingest, rng, t * share, (t + 1) * share, 1000);
+      });
+    for (size_t t = 0; t < threads.size(); ++t)
+      threads[t].join();
+    // The destructor finishes every submitted chunk
+  }
+  streams.expectSameAsTinyGPSPlus(pool);
+}
+
+} // namespace
@@ -0,0 +1,188 @@
+// Tests that commit listeners are called for the fields and sentence types
+// they asked for, on both encode paths, and see the whole committed fix.
+
+#include "NMEAGenerator.h"
+#include "TinyGPS++.h"
+
+#include <gtest/gtest.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+#if _GPS_MAX_LISTENERS > 0
+
+// What a listener saw at each call
+struct Calls {
+  std::vector<TinyGPSCommit> commits;
+  std::vector<TinyGPSFix> fixes;
+  std::vector<std::string> customs;
+  TinyGPSCustom *custom = NULL;
+
+  static void record(TinyGPSPlus &gps, const TinyGPSCommit &commit,
+                     void *context) {
+    Calls *calls = (Calls *)context;
+    calls->commits.push_back(commit);
+    calls->fixes.push_back(gps.fix());
+    if (calls->custom != NULL)
+      calls->customs.push_back(calls->custom->value());
+  }
+
+  std::vector<uint8_t> sentences() const {
+    std::vector<uint8_t> types;
+    for (size_t i = 0; i < commits.size(); ++i)
+      types.push_back(commits[i].sentence);
+    return types;
+  }
+};
+
+std::string fourSentences() {
+  std::string stream;
+  bench::appendSentence(stream, "GPRMC,123519,A,4807.038,N,01131.000,E,022.4,"
+                                "084.4,230394,003.1,W");
+  bench::appendSentence(stream, "GPGSA,A,3,04,05,,09,12,,,24,,,,,2.5,1.3,2.1");
+  bench::appendSentence(stream, "GPGGA,123520,4807.040,N,01131.000,E,1,08,0.9,"
+                                "545.4,M,46.9,M,,");
+  bench::appendSentence(stream, "PUBX,00,123521.00,4807.041,N");
+  return stream;
+}
+
+// Feeds stream a character at a time when bytewise, else in one call
+void feed(TinyGPSPlus &gps, const std::string &stream, bool bytewise) {
+  if (bytewise) {
+    for (size_t i = 0; i < stream.size(); ++i)
+      gps.encode(stream[i]);
+  } else {
+    gps.encode(stream.data(), stream.size());
+  }
+}
+
+class ListenerTest : public ::testing::TestWithParam<bool> {};
+
+TEST_P(ListenerTest, FieldMask) {
+  TinyGPSPlus gps;
+  Calls date, hdop, location;
+  ASSERT_TRUE(gps.addListener(Calls::record, &date, TinyGPSPlus::COMMIT_DATE));
+  ASSERT_TRUE(gps.addListener(Calls::record, &hdop, TinyGPSPlus::COMMIT_HDOP));
+  ASSERT_TRUE(gps.addListener(
+      Calls::record, &location,
+      TinyGPSPlus::COMMIT_LOCATION | TinyGPSPlus::COMMIT_PDOP));
+  feed(gps, fourSentences(), GetParam());
+
+  EXPECT_EQ(std::vector<uint8_t>({TinyGPSPlus::GPS_SENTENCE_RMC}),
+            date.sentences());
+  EXPECT_EQ(std::vector<uint8_t>({TinyGPSPlus::GPS_SENTENCE_GSA,
+                                  TinyGPSPlus::GPS_SENTENCE_GGA}),
+            hdop.sentences());
+  EXPECT_EQ(std::vector<uint8_t>({TinyGPSPlus::GPS_SENTENCE_RMC,
+                                  TinyGPSPlus::GPS_SENTENCE_GSA,
+                                  TinyGPSPlus::GPS_SENTENCE_GGA}),
+            location.sentences());
+
+  // The fields are those the sentence committed, not only those asked for
+  ASSERT_EQ(3u, location.commits.size());
+  EXPECT_EQ(TinyGPSPlus::COMMIT_DATE | TinyGPSPlus::COMMIT_TIME |
+                TinyGPSPlus::COMMIT_LOCATION | TinyGPSPlus::COMMIT_SPEED |
+                TinyGPSPlus::COMMIT_COURSE,
+            location.commits[0].fields);
+  EXPECT_EQ(TinyGPSPlus::COMMIT_FIX_MODE | TinyGPSPlus::COMMIT_PDOP |
+                TinyGPSPlus::COMMIT_HDOP | TinyGPSPlus::COMMIT_VDOP,
+            location.commits[1].fields);
+}
+
+TEST_P(ListenerTest, SentenceMask) {
+  TinyGPSPlus gps;
+  TinyGPSCustom ubx(gps, "PUBX", 2);
+  Calls other, gsa;
+  other.custom = &ubx;
+  ASSERT_TRUE(gps.addListener(Calls::record, &other, 0,
+                              1 << TinyGPSPlus::GPS_SENTENCE_OTHER));
+  ASSERT_TRUE(gps.addListener(Calls::record, &gsa, 0,
+                              1 << TinyGPSPlus::GPS_SENTENCE_GSA));
+  std::string stream = fourSentences();
+  // Failed sentences call nobody
+  stream += "$PUBX,00,123522.00*00\r\n";
+  feed(gps, stream, GetParam());
+
+  ASSERT_EQ(std::vector<uint8_t>({TinyGPSPlus::GPS_SENTENCE_OTHER}),
+            other.sentences());
+  EXPECT_EQ(0, other.commits[0].fields);
+  // Custom fields are committed before the call
+  EXPECT_EQ(std::vector<std::string>({"123521.00"}), other.customs);
+  EXPECT_EQ(std::vector<uint8_t>({TinyGPSPlus::GPS_SENTENCE_GSA}),
+            gsa.sentences());
+}
+
+TEST_P(ListenerTest, RemoveListener) {
+  TinyGPSPlus gps;
+  std::vector<Calls> calls(_GPS_MAX_LISTENERS + 1);
+  for (int i = 0; i < _GPS_MAX_LISTENERS; ++i)
+    ASSERT_TRUE(gps.addListener(Calls::record, &calls[i],
+                                TinyGPSPlus::COMMIT_TIME));
+  EXPECT_FALSE(gps.addListener(Calls::record, &calls[_GPS_MAX_LISTENERS],
+                               TinyGPSPlus::COMMIT_TIME));
+
+  // Removing one frees its slot; removing one never added does nothing
+  gps.removeListener(Calls::record, &calls[0]);
+  gps.removeListener(Calls::record, &calls[_GPS_MAX_LISTENERS]);
+  EXPECT_TRUE(gps.addListener(Calls::record, &calls[_GPS_MAX_LISTENERS],
+                              TinyGPSPlus::COMMIT_TIME));
+  feed(gps, fourSentences(), GetParam());
+
+  EXPECT_TRUE(calls[0].commits.empty());
+  for (int i = 1; i <= _GPS_MAX_LISTENERS; ++i)
+    EXPECT_EQ(2u, calls[i].commits.size()) << i;
+}
+
+// The callback sees the fix as of the sentence that called it, with every
+// field of that sentence committed
+TEST_P(ListenerTest, SeesCommittedSnapshot) {
+  TinyGPSClock::hold(5000);
+  TinyGPSPlus gps;
+  Calls calls;
+  ASSERT_TRUE(gps.addListener(Calls::record, &calls,
+                              TinyGPSPlus::COMMIT_LOCATION));
+  std::string stream = fourSentences();
+  bench::appendSentence(stream, "GPRMC,123523,A,5107.038,S,00131.000,W,"
+                                "010.0,180.0,240394,003.1,W");
+  feed(gps, stream, GetParam());
+  TinyGPSClock::release();
+
+  ASSERT_EQ(3u, calls.fixes.size());
+  const TinyGPSFix &rmc = calls.fixes[0];
+  EXPECT_EQ(48117300000, rmc.latitude);
+  EXPECT_EQ(12351900u, rmc.time);
+  EXPECT_EQ(230394u, rmc.date);
+  EXPECT_EQ(2240, rmc.speed);
+  EXPECT_EQ(calls.commits[0].fields, rmc.updated);
+  EXPECT_EQ(5000u, rmc.commitTime);
+  EXPECT_EQ(5000u, calls.commits[0].time);
+
+  const TinyGPSFix &gga = calls.fixes[1];
+  EXPECT_EQ(48117333333, gga.latitude);
+  EXPECT_EQ(12352000u, gga.time);
+  EXPECT_EQ(54540, gga.altitude);
+  EXPECT_EQ(8u, gga.satellites);
+  EXPECT_EQ(230394u, gga.date);
+  EXPECT_EQ(calls.commits[1].fields, gga.updated);
+
+  const TinyGPSFix &last = calls.fixes[2];
+  EXPECT_EQ(-51117300000, last.latitude);
+  EXPECT_EQ(-1516666667, last.longitude);
+  EXPECT_EQ(12352300u, last.time);
+  EXPECT_EQ(240394u, last.date);
+  EXPECT_EQ(1000, last.speed);
+  EXPECT_EQ(54540, last.altitude);
+  TinyGPSFix now = gps.fix();
+  EXPECT_EQ(0, memcmp(&last, &now, sizeof(last)));
+}
+
+INSTANTIATE_TEST_SUITE_P(BothPaths, ListenerTest, ::testing::Bool(),
+                         [](const ::testing::TestParamInfo<bool> &info) {
+                           return info.param ? "Bytewise" : "Bulk";
+                         });
+
+#endif
+
+} // namespace
@@ -0,0 +1,154 @@
+// Tests that TinyGPSLogReader maps a capture file and hands out the same
+// sentences, and feeds encode() the same bytes, as reading it would.
+
+#include "NMEAGenerator.h"
+#include "TinyGPS++.h"
+#include "TinyGPSLogReader.h"
+
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+// A temporary file holding the given bytes, removed when it goes out of
+// scope
+struct TempLog {
+  std::string path;
+
+  explicit TempLog(const std::string &content) {
+    char name[] = "/tmp/tinygps_log_XXXXXX";
+    int fd = mkstemp(name);
+    FILE *f = fdopen(fd, "wb");
+    fwrite(content.data(), 1, content.size(), f);
+    fclose(f);
+    path = name;
+  }
+  ~TempLog() { remove(path.c_str()); }
+};
+
+const char *kRMC = "GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,"
+                   "003.1,W";
+const char *kGGA = "GPGGA,123520,4807.040,N,01131.000,E,1,08,0.9,545.4,M,"
+                   "46.9,M,,";
+
+std::string sentence(const char *body) {
+  std::string s;
+  bench::appendSentence(s, body);
+  s.resize(s.size() - 2);
+  return s;
+}
+
+std::vector<std::string> readAll(TinyGPSLogReader &reader) {
+  std::vector<std::string> sentences;
+  std::string_view s;
+  while (reader.nextSentence(s))
+    sentences.push_back(std::string(s));
+  return sentences;
+}
+
+uint32_t encodeBytes(const std::string &log) {
+  TinyGPSPlus gps;
+  for (size_t i = 0; i < log.size(); ++i)
+    gps.encode(log[i]);
+  return gps.passedChecksum();
+}
+
+TEST(LogReaderTest, SentenceBoundaries) {
+  // Text outside sentences, each line ending, a sentence cut short by the
+  // next '$' and one whose checksum fails
+  std::string rmc = sentence(kRMC), gga = sentence(kGGA);
+  std::string bad = rmc;
+  bad[bad.size() - 1] = bad[bad.size() - 1] == '0' ? '1' : '0';
+  std::string log = "noise\r\n" + rmc + "\r\n" + gga + "\n" + "$GPGSA,A,3" +
+                    rmc + "\r" + bad + "\r\ntrailing text\n";
+  TempLog file(log);
+
+  TinyGPSLogReader reader;
+  ASSERT_TRUE(reader.open(file.path.c_str()));
+  EXPECT_TRUE(reader.isOpen());
+  EXPECT_EQ(log.size(), reader.size());
+  EXPECT_EQ(log, std::string(reader.view()));
+
+  std::vector<std::string> want = {rmc, gga, "$GPGSA,A,3", rmc, bad};
+  EXPECT_EQ(want, readAll(reader));
+
+  // The sentences point into the mapping, and split into terms as they
+  // would from a copy
+  reader.rewind();
+  const char *begin, *end;
+  ASSERT_TRUE(reader.nextSentence(begin, end));
+  EXPECT_EQ(reader.data() + 7, begin);
+  TinyGPSSentence parsed;
+  for (size_t i = 1; i < want.size(); ++i) {
+    ASSERT_TRUE(reader.nextSentence(parsed));
+    EXPECT_EQ(i == 1 || i == 3, parsed.isValid()) << want[i];
+  }
+  EXPECT_FALSE(reader.nextSentence(parsed));
+
+  for (size_t slice = 1; slice <= log.size(); slice += 13) {
+    TinyGPSPlus gps;
+    EXPECT_EQ(3u, reader.encodeInto(gps, slice)) << slice;
+    EXPECT_EQ(encodeBytes(log), gps.passedChecksum());
+    EXPECT_EQ(1u, gps.failedChecksum()); // the cut GSA has no checksum
+  }
+}
+
+TEST(LogReaderTest, EmptyFile) {
+  TempLog file("");
+  TinyGPSLogReader reader;
+  ASSERT_TRUE(reader.open(file.path.c_str()));
+  EXPECT_TRUE(reader.isOpen());
+  EXPECT_EQ(0u, reader.size());
+  EXPECT_TRUE(reader.view().empty());
+
+  std::string_view s;
+  EXPECT_FALSE(reader.nextSentence(s));
+  TinyGPSPlus gps;
+  EXPECT_EQ(0u, reader.encodeInto(gps));
+  EXPECT_EQ(0u, gps.charsProcessed());
+
+  reader.close();
+  EXPECT_FALSE(reader.isOpen());
+  EXPECT_FALSE(reader.open((file.path + ".missing").c_str()));
+  EXPECT_FALSE(reader.isOpen());
+}
+
+// The last sentence runs to the end of the file. encode() waits for a line
+// ending that never comes, so it is handed out but not committed.
+TEST(LogReaderTest, NoTrailingNewline) {
+  std::string rmc = sentence(kRMC), gga = sentence(kGGA);
+  std::string log = rmc + "\r\n" + gga;
+  TempLog file(log);
+
+  TinyGPSLogReader reader;
+  ASSERT_TRUE(reader.open(file.path.c_str()));
+  std::vector<std::string> want = {rmc, gga};
+  EXPECT_EQ(want, readAll(reader));
+
+  reader.rewind();
+  TinyGPSSentence parsed;
+  ASSERT_TRUE(reader.nextSentence(parsed));
+  ASSERT_TRUE(reader.nextSentence(parsed));
+  EXPECT_TRUE(parsed.isValid());
+  EXPECT_TRUE(parsed.term(9).equals("545.4"));
+
+  TinyGPSPlus gps;
+  EXPECT_EQ(1u, reader.encodeInto(gps, 16));
+  EXPECT_EQ(encodeBytes(log), gps.passedChecksum());
+  EXPECT_EQ(12351900u, gps.time.value());
+
+  // A sentence cut off inside its checksum
+  TempLog cut(rmc + "\r\n" + gga.substr(0, gga.size() - 1));
+  ASSERT_TRUE(reader.open(cut.path.c_str()));
+  ASSERT_EQ(2u, readAll(reader).size());
+  reader.rewind();
+  ASSERT_TRUE(reader.nextSentence(parsed));
+  ASSERT_TRUE(reader.nextSentence(parsed));
+  EXPECT_FALSE(parsed.isValid());
+}
+
+} // namespace
@@ -0,0 +1,89 @@
+// Macro benchmarks: replay mixed RMC/GGA/GSA/GSV corpora (GPS and GLONASS
+// satellites) at common update rates through TinyGPSPlus, with and without
+// the custom fields a satellite tracking application registers, and report
+// bytes/s and sentences/s.
+
+#include "NMEAGenerator.h"
+#include "TinyGPS++.h"
+
+#include <benchmark/benchmark.h>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace {
+
+const unsigned corpusSeconds = 600;
+
+const std::string &corpus(unsigned rateHz) {
+  static std::map<unsigned, std::string> corpora;
+  std::string &c = corpora[rateHz];
+  if (c.empty()) {
+    bench::NMEAGenerator::Options options;
+    options.rateHz = rateHz;
+    options.talkers = {"GP", "GL"};
+    c = bench::NMEAGenerator(options).seconds(corpusSeconds);
+  }
+  return c;
+}
+
+// The custom fields of a satellite tracker: every GSV and GSA term, plus the
+// RMC and GGA terms that TinyGPSPlus does not decode itself
+struct Tracker {
+  TinyGPSPlus gps;
+  TinyGPSCustom gpgsv[19], glgsv[19], gpgsa[17], gprmc[3], gpgga[5];
+
+  Tracker() {
+    for (int i = 0; i < 19; ++i) {
+      gpgsv[i].begin(gps, "GPGSV", i + 1);
+      glgsv[i].begin(gps, "GLGSV", i + 1);
+    }
+    for (int i = 0; i < 17; ++i)
+      gpgsa[i].begin(gps, "GPGSA", i + 1);
+    for (int i = 0; i < 3; ++i)
+      gprmc[i].begin(gps, "GPRMC", i + 10);
+    for (int i = 0; i < 5; ++i)
+      gpgga[i].begin(gps, "GPGGA", i + 10);
+  }
+};
+
+void setCounters(benchmark::State &state, const std::string &data) {
+  state.SetBytesProcessed(state.iterations() * data.size());
+  state.counters["sentences"] = benchmark::Counter(
+      (double)state.iterations() * bench::countSentences(data),
+      benchmark::Counter::kIsRate);
+}
+
+// range(0): update rate in Hz, range(1): 1 to register the tracker's
+// custom fields
+void BM_ReplayBulk(benchmark::State &state) {
+  const std::string &data = corpus(state.range(0));
+  std::unique_ptr<Tracker> tracker(new Tracker);
+  TinyGPSPlus plain;
+  TinyGPSPlus &gps = state.range(1) ? tracker->gps : plain;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(gps.encode(data.data(), data.size()));
+  setCounters(state, data);
+}
+
+void BM_ReplayPerByte(benchmark::State &state) {
+  const std::string &data = corpus(state.range(0));
+  std::unique_ptr<Tracker> tracker(new Tracker);
+  TinyGPSPlus plain;
+  TinyGPSPlus &gps = state.range(1) ? tracker->gps : plain;
+  for (auto _ : state)
+    for (char c : data)
+      benchmark::DoNotOptimize(gps.encode(c));
+  setCounters(state, data);
+}
+
+BENCHMARK(BM_ReplayBulk)
+    ->ArgNames({"hz", "custom"})
+    ->ArgsProduct({{1, 5, 10, 20}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ReplayPerByte)
+    ->ArgNames({"hz", "custom"})
+    ->ArgsProduct({{1, 5, 10, 20}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,329 @@
+// Micro benchmarks for the individual stages of TinyGPSPlus.
+
+#include "NMEAGenerator.h"
+#include "TinyGPS++.h"
+#include "TinyGPSSatellites.h"
+
+#include <benchmark/benchmark.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+const char rmc[] = "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,"
+                   "003.1,W*6A\r\n";
+
+std::string repeated(const char *sentence, size_t count) {
+  std::string out;
+  for (size_t i = 0; i < count; ++i)
+    out += sentence;
+  return out;
+}
+
+// Per-byte encode(char), the interface the Arduino examples use
+void BM_EncodePerByte(benchmark::State &state) {
+  std::string data = repeated(rmc, 64);
+  TinyGPSPlus gps;
+  for (auto _ : state)
+    for (char c : data)
+      benchmark::DoNotOptimize(gps.encode(c));
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_EncodePerByte);
+
+// Bulk encode(const char *, size_t) over the same data
+void BM_EncodeBulk(benchmark::State &state) {
+  std::string data = repeated(rmc, 64);
+  TinyGPSPlus gps;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(gps.encode(data.data(), data.size()));
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_EncodeBulk);
+
+void BM_ParseDecimal(benchmark::State &state) {
+  const char *const fields[] = {"123519.00", "022.4", "-12.7", "545.4"};
+  for (auto _ : state)
+    for (const char *f : fields)
+      benchmark::DoNotOptimize(TinyGPSPlus::parseDecimal(f));
+  state.SetItemsProcessed(state.iterations() * 4);
+}
+BENCHMARK(BM_ParseDecimal);
+
+void BM_ParseDegrees(benchmark::State &state) {
+  const char *const fields[] = {"4807.038123", "01131.000456", "3751.65",
+                                "17959.9999999"};
+  RawDegrees deg;
+  for (auto _ : state)
+    for (const char *f : fields) {
+      TinyGPSPlus::parseDegrees(f, deg);
+      benchmark::DoNotOptimize(deg);
+    }
+  state.SetItemsProcessed(state.iterations() * 4);
+}
+BENCHMARK(BM_ParseDegrees);
+
+void BM_VerifySentence(benchmark::State &state) {
+  const char *end = rmc + strlen(rmc);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(TinyGPSPlus::verifySentence(rmc, end));
+  state.SetBytesProcessed(state.iterations() * (end - rmc));
+}
+BENCHMARK(BM_VerifySentence);
+
+// Sentence type dispatch: sentences that end right after their address
+// field, so identifying the type is almost all of the work
+void BM_SentenceDispatch(benchmark::State &state) {
+  std::string data;
+  const char *const names[] = {"GPRMC", "GNGGA", "GPGSV", "GLGSV",
+                               "GPGSA", "GPVTG", "PUBX",  "GAGGA"};
+  for (const char *name : names)
+    bench::appendSentence(data, name);
+  TinyGPSPlus gps;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(gps.encode(data.data(), data.size()));
+  state.SetItemsProcessed(state.iterations() * 8);
+}
+BENCHMARK(BM_SentenceDispatch);
+
+// GSV sentences with state.range(0) custom fields registered on GPGSV terms
+void BM_CustomDispatch(benchmark::State &state) {
+  std::string data;
+  bench::appendSentence(
+      data, "GPGSV,3,1,11,03,03,111,00,04,15,270,00,06,01,010,00,13,06,292,00");
+  TinyGPSPlus gps;
+  std::vector<TinyGPSCustom> customs(state.range(0));
+  for (size_t i = 0; i < customs.size(); ++i)
+    customs[i].begin(gps, "GPGSV", 1 + i % 19);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(gps.encode(data.data(), data.size()));
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CustomDispatch)->Arg(0)->Arg(19)->Arg(64);
+
+// A three message GSV group, decoded as in SatelliteTracker.ino with 19
+// custom fields read after every message, then with a TinyGPSSatellites
+// table read once per group
+std::vector<std::string> gsvGroup() {
+  std::vector<std::string> messages(3);
+  bench::appendSentence(
+      messages[0],
+      "GPGSV,3,1,11,03,03,111,00,04,15,270,00,06,01,010,00,13,06,292,00");
+  bench::appendSentence(
+      messages[1],
+      "GPGSV,3,2,11,14,25,170,00,16,57,208,39,18,67,296,40,19,40,246,00");
+  bench::appendSentence(messages[2],
+                        "GPGSV,3,3,11,22,42,067,42,24,14,311,43,27,05,244,00,"
+                        ",,,");
+  return messages;
+}
+
+void BM_SatellitesCustom(benchmark::State &state) {
+  std::vector<std::string> messages = gsvGroup();
+  TinyGPSPlus gps;
+  TinyGPSCustom customs[19];
+  for (int i = 0; i < 19; ++i)
+    customs[i].begin(gps, "GPGSV", i + 1);
+  int sum = 0;
+  for (auto _ : state)
+    for (const std::string &m : messages) {
+      gps.encode(m.data(), m.size());
+      for (int i = 3; i < 19; ++i)
+        sum += atoi(customs[i].value());
+    }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations() * 3);
+}
+BENCHMARK(BM_SatellitesCustom);
+
+void BM_SatellitesTable(benchmark::State &state) {
+  std::vector<std::string> messages = gsvGroup();
+  TinyGPSPlus gps;
+  TinyGPSSatellites sats(gps);
+  int sum = 0;
+  for (auto _ : state) {
+    for (const std::string &m : messages)
+      gps.encode(m.data(), m.size());
+    for (uint8_t i = 0, n = sats.count(); i < n; ++i)
+      sum += sats.prn(i) + sats.elevation(i) + sats.azimuth(i) + sats.snr(i);
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations() * 3);
+}
+BENCHMARK(BM_SatellitesTable);
+
+// One fix as NMEA text, RMC and GGA, and as the equivalent UBX NAV-PVT
+// frame, both through the bulk encode()
+std::string navPvtFrame() {
+  unsigned char payload[92] = {0};
+  auto put = [&](size_t offset, uint32_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i)
+      payload[offset + i] = (unsigned char)(value >> (8 * i));
+  };
+  put(4, 1994, 2);       // year
+  put(6, 3, 1);          // month
+  put(7, 23, 1);         // day
+  put(8, 12, 1);         // hour
+  put(9, 35, 1);         // minute
+  put(10, 19, 1);        // second
+  put(11, 3, 1);         // date and time valid
+  put(20, 3, 1);         // 3D fix
+  put(21, 1, 1);         // GNSS fix OK
+  put(23, 8, 1);         // satellites
+  put(24, 115166667, 4); // longitude
+  put(28, 481173000, 4); // latitude
+  put(36, 545400, 4);    // height above MSL
+  put(60, 11524, 4);     // ground speed
+  put(64, 8440000, 4);   // heading
+  put(76, 90, 2);        // PDOP
+
+  std::string frame("\xB5\x62\x01\x07\x5C\x00", 6);
+  frame.append((const char *)payload, sizeof(payload));
+  uint8_t a = 0, b = 0;
+  for (size_t i = 2; i < frame.size(); ++i) {
+    a += (uint8_t)frame[i];
+    b += a;
+  }
+  frame += (char)a;
+  frame += (char)b;
+  return frame;
+}
+
+void BM_FixNMEA(benchmark::State &state) {
+  std::string fix = rmc;
+  fix += "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47"
+         "\r\n";
+  TinyGPSPlus gps;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(gps.encode(fix.data(), fix.size()));
+  state.SetBytesProcessed(state.iterations() * fix.size());
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FixNMEA);
+
+void BM_FixUBX(benchmark::State &state) {
+  std::string fix = navPvtFrame();
+  TinyGPSPlus gps;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(gps.encode(fix.data(), fix.size()));
+  state.SetBytesProcessed(state.iterations() * fix.size());
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FixUBX);
+
+// Reading a whole fix through the accessors, then as one TinyGPSFix
+void BM_ReadAccessors(benchmark::State &state) {
+  TinyGPSPlus gps;
+  gps.encode(rmc, sizeof(rmc) - 1);
+  double sum = 0;
+  for (auto _ : state) {
+    benchmark::ClobberMemory();
+    sum += gps.location.lat() + gps.location.lng() + gps.date.value() +
+           gps.time.value() + gps.speed.value() + gps.course.value() +
+           gps.altitude.value() + gps.satellites.value() + gps.hdop.value();
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ReadAccessors);
+
+void BM_ReadFix(benchmark::State &state) {
+  TinyGPSPlus gps;
+  gps.encode(rmc, sizeof(rmc) - 1);
+  double sum = 0;
+  for (auto _ : state) {
+    benchmark::ClobberMemory();
+    TinyGPSFix fix = gps.fix();
+    sum += fix.lat() + fix.lng() + fix.date + fix.time + fix.speed +
+           fix.course + fix.altitude + fix.satellites + fix.hdop;
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ReadFix);
+
+// The RMC sentences of BM_EncodeBulk with a 1074 RTCM3 frame of 200
+// bytes after each, as from a base station sharing the port
+void BM_EncodeWithRTCM(benchmark::State &state) {
+  std::string frame(206, '\0');
+  frame[0] = (char)0xD3;
+  frame[2] = (char)200;
+  frame[3] = (char)(1074 >> 4);
+  frame[4] = (char)((1074 & 0xF) << 4);
+  for (size_t i = 5; i < 203; ++i)
+    frame[i] = "$,*\r\n"[i % 5]; // NMEA delimiters inside the payload
+  uint32_t crc =
+      TinyGPSRTCM::crc24q(0, (const uint8_t *)frame.data(), frame.size() - 3);
+  frame[203] = (char)(crc >> 16);
+  frame[204] = (char)(crc >> 8);
+  frame[205] = (char)crc;
+
+  std::string data;
+  for (int i = 0; i < 64; ++i)
+    data += std::string(rmc) + frame;
+  TinyGPSPlus gps;
+  for (auto _ : state)
+    benchmark::DoNotOptimize(gps.encode(data.data(), data.size()));
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_EncodeWithRTCM);
+
+// Reacting to each new location, fed per byte as in FullExample.ino: by
+// polling isUpdated() after every character, then with a commit listener
+void BM_PollUpdated(benchmark::State &state) {
+  std::string data = repeated(rmc, 64);
+  TinyGPSPlus gps;
+  double sum = 0;
+  for (auto _ : state)
+    for (char c : data) {
+      gps.encode(c);
+      if (gps.isUpdated() && gps.location.isUpdated())
+        sum += gps.location.lat();
+    }
+  benchmark::DoNotOptimize(sum);
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_PollUpdated);
+
+void addLatitude(TinyGPSPlus &gps, const TinyGPSCommit &, void *context) {
+  *(double *)context += gps.location.lat();
+}
+
+void BM_CommitListener(benchmark::State &state) {
+  std::string data = repeated(rmc, 64);
+  TinyGPSPlus gps;
+  double sum = 0;
+  gps.addListener(addLatitude, &sum, TinyGPSPlus::COMMIT_LOCATION);
+  for (auto _ : state)
+    for (char c : data)
+      gps.encode(c);
+  benchmark::DoNotOptimize(sum);
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_CommitListener);
+
+void BM_DistanceBetween(benchmark::State &state) {
+  double lat = 48.1173, lng = 11.5167;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        TinyGPSPlus::distanceBetween(lat, lng, 51.508131, -0.128002));
+    lat += 1e-6;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_DistanceBetween);
+
+void BM_CourseTo(benchmark::State &state) {
+  double lat = 48.1173, lng = 11.5167;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        TinyGPSPlus::courseTo(lat, lng, 51.508131, -0.128002));
+    lat += 1e-6;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CourseTo);
+
+} // namespace
@@ -0,0 +1,183 @@
+// nmea_gen: write a synthetic NMEA stream for load and soak testing.
+//
+//   nmea_gen --bytes 4G --rate 10 --talkers GN,GP,GL,GA -o big.nmea
+//   nmea_gen --seconds 3600 --corrupt 0.01 --truncate 0.01 --overlong 0.01
+//            --line-ending mixed | ./replay
+//
+// See usage() for every option. Output is identical for identical options.
+
+#include "NMEAGenerator.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+void usage(const char *argv0) {
+  fprintf(stderr,
+          "usage: %s [options]\n"
+          "  --bytes N[K|M|G]     stop after at least N bytes\n"
+          "  --seconds N          stop after N seconds of epochs (default 60)\n"
+          "  --seed N             PRNG seed (default 1)\n"
+          "  --rate HZ            position epochs per second (default 1)\n"
+          "  --slow-rate HZ       GSA/GSV/GST/ZDA per second (default 1)\n"
+          "  --sentences LIST     comma-separated subset of\n"
+          "                       rmc,gga,gsa,gsv,vtg,gll,zda,gns,gst\n"
+          "                       (default rmc,gga,gsa,gsv)\n"
+          "  --talkers LIST       comma-separated talker IDs (default GP)\n"
+          "  --satellites N       satellites in view per talker (default 12)\n"
+          "  --line-ending E      crlf, lf, cr or mixed (default crlf)\n"
+          "  --corrupt P          probability of a bad checksum\n"
+          "  --truncate P         probability of a truncated sentence\n"
+          "  --overlong P         probability of a field longer than\n"
+          "                       _GPS_MAX_FIELD_SIZE\n"
+          "  -o FILE              output file (default stdout)\n",
+          argv0);
+  exit(2);
+}
+
+std::vector<std::string> split(const char *list) {
+  std::vector<std::string> out;
+  std::string item;
+  for (const char *p = list;; ++p) {
+    if (*p == ',' || *p == '\0') {
+      if (!item.empty())
+        out.push_back(item);
+      item.clear();
+      if (*p == '\0')
+        return out;
+    } else {
+      item += *p;
+    }
+  }
+}
+
+unsigned long long parseSize(const char *s) {
+  char *suffix;
+  unsigned long long n = strtoull(s, &suffix, 10);
+  switch (*suffix) {
+  case 'G':
+  case 'g':
+    n <<= 10; // fall through
+  case 'M':
+  case 'm':
+    n <<= 10; // fall through
+  case 'K':
+  case 'k':
+    n <<= 10;
+  }
+  return n;
+}
+
+unsigned parseSentences(const char *list, const char *argv0) {
+  static const struct {
+    const char *name;
+    unsigned bit;
+  } names[] = {
+      {"rmc", bench::NMEAGenerator::RMC}, {"gga", bench::NMEAGenerator::GGA},
+      {"gsa", bench::NMEAGenerator::GSA}, {"gsv", bench::NMEAGenerator::GSV},
+      {"vtg", bench::NMEAGenerator::VTG}, {"gll", bench::NMEAGenerator::GLL},
+      {"zda", bench::NMEAGenerator::ZDA}, {"gns", bench::NMEAGenerator::GNS},
+      {"gst", bench::NMEAGenerator::GST},
+  };
+  unsigned mask = 0;
+  for (const std::string &item : split(list)) {
+    unsigned bit = 0;
+    for (const auto &n : names)
+      if (item == n.name)
+        bit = n.bit;
+    if (!bit) {
+      fprintf(stderr, "unknown sentence '%s'\n", item.c_str());
+      usage(argv0);
+    }
+    mask |= bit;
+  }
+  return mask;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  bench::NMEAGenerator::Options options;
+  unsigned long long bytes = 0;
+  unsigned seconds = 60;
+  const char *path = NULL;
+
+  for (int i = 1; i < argc; ++i) {
+    const char *arg = argv[i];
+    if (i + 1 >= argc)
+      usage(argv[0]);
+    const char *value = argv[++i];
+    if (!strcmp(arg, "--bytes"))
+      bytes = parseSize(value);
+    else if (!strcmp(arg, "--seconds"))
+      seconds = (unsigned)strtoul(value, NULL, 10);
+    else if (!strcmp(arg, "--seed"))
+      options.seed = (uint32_t)strtoul(value, NULL, 10);
+    else if (!strcmp(arg, "--rate"))
+      options.rateHz = (unsigned)strtoul(value, NULL, 10);
+    else if (!strcmp(arg, "--slow-rate"))
+      options.slowRateHz = (unsigned)strtoul(value, NULL, 10);
+    else if (!strcmp(arg, "--sentences"))
+      options.sentences = parseSentences(value, argv[0]);
+    else if (!strcmp(arg, "--talkers"))
+      options.talkers = split(value);
+    else if (!strcmp(arg, "--satellites"))
+      options.satellites = (unsigned)strtoul(value, NULL, 10);
+    else if (!strcmp(arg, "--corrupt"))
+      options.corruptChecksum = atof(value);
+    else if (!strcmp(arg, "--truncate"))
+      options.truncate = atof(value);
+    else if (!strcmp(arg, "--overlong"))
+      options.overlongField = atof(value);
+    else if (!strcmp(arg, "-o"))
+      path = value;
+    else if (!strcmp(arg, "--line-ending")) {
+      if (!strcmp(value, "crlf"))
+        options.lineEnding = bench::NMEAGenerator::CRLF;
+      else if (!strcmp(value, "lf"))
+        options.lineEnding = bench::NMEAGenerator::LF;
+      else if (!strcmp(value, "cr"))
+        options.lineEnding = bench::NMEAGenerator::CR;
+      else if (!strcmp(value, "mixed"))
+        options.lineEnding = bench::NMEAGenerator::MIXED;
+      else
+        usage(argv[0]);
+    } else
+      usage(argv[0]);
+  }
+
+  FILE *out = path ? fopen(path, "wb") : stdout;
+  if (!out) {
+    perror(path);
+    return 1;
+  }
+
+  // Generate and write in blocks of about 1 MiB
+  const size_t block = 1 << 20;
+  bench::NMEAGenerator generator(options);
+  unsigned long long epochs =
+      (unsigned long long)seconds * (options.rateHz ? options.rateHz : 1);
+  unsigned long long written = 0, epoch = 0;
+  std::string buffer;
+  buffer.reserve(block + 4096);
+  for (;;) {
+    bool done = bytes ? written + buffer.size() >= bytes : epoch >= epochs;
+    if (done || buffer.size() >= block) {
+      if (fwrite(buffer.data(), 1, buffer.size(), out) != buffer.size()) {
+        perror(path ? path : "stdout");
+        return 1;
+      }
+      written += buffer.size();
+      buffer.clear();
+      if (done)
+        break;
+    }
+    generator.nextEpoch(buffer);
+    ++epoch;
+  }
+  return fclose(out) == 0 ? 0 : 1;
+}
@@ -0,0 +1,399 @@
+// Deterministic synthetic NMEA stream generator for benchmarks and soak
+// tests.
+//
+// The stream is a sequence of receiver epochs. Every epoch emits the enabled
+// position sentences (RMC, GGA, GLL, GNS, VTG) for a simulated moving
+// receiver; the slower satellite sentences (GSA, GSV, GST, ZDA) are emitted at
+// their own rate, one GSA and one GSV group per talker ID. Noise can corrupt
+// checksums, truncate sentences, stretch fields past _GPS_MAX_FIELD_SIZE and
+// vary line endings. The same options and seed always give the same bytes.
+
+#ifndef TINYGPS_BENCH_NMEA_GENERATOR_H
+#define TINYGPS_BENCH_NMEA_GENERATOR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+/// Small deterministic PRNG (xorshift32)
+class Random {
+public:
+  explicit Random(uint32_t seed) : state(seed ? seed : 1) {}
+
+  uint32_t next() {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+  }
+
+  /// Uniform value in [0, n)
+  uint32_t below(uint32_t n) { return next() % n; }
+
+  /// True with the given probability
+  bool chance(double probability) {
+    return probability > 0 && next() < probability * 4294967296.0;
+  }
+
+private:
+  uint32_t state;
+};
+
+/// Append "$<body>*hh\r\n" to out
+inline void appendSentence(std::string &out, const std::string &body) {
+  static const char hex[] = "0123456789ABCDEF";
+  uint8_t parity = 0;
+  for (char c : body)
+    parity ^= (uint8_t)c;
+  out += '$';
+  out += body;
+  out += '*';
+  out += hex[parity >> 4];
+  out += hex[parity & 15];
+  out += "\r\n";
+}
+
+/// Number of '$' sentence starts in a stream
+inline size_t countSentences(const std::string &stream) {
+  size_t n = 0;
+  for (char c : stream)
+    n += c == '$';
+  return n;
+}
+
+/// \brief Synthetic NMEA stream generator
+class NMEAGenerator {
+public:
+  /// Sentence types, usable as bits of Options::sentences
+  enum Sentence {
+    RMC = 1 << 0,
+    GGA = 1 << 1,
+    GSA = 1 << 2,
+    GSV = 1 << 3,
+    VTG = 1 << 4,
+    GLL = 1 << 5,
+    ZDA = 1 << 6,
+    GNS = 1 << 7,
+    GST = 1 << 8,
+  };
+
+  /// Line ending written after each sentence
+  enum LineEnding { CRLF, LF, CR, MIXED };
+
+  struct Options {
+    uint32_t seed = 1;
+    unsigned rateHz = 1;     ///< position epochs per second
+    unsigned slowRateHz = 1; ///< GSA/GSV/GST/ZDA emissions per second
+    unsigned sentences = RMC | GGA | GSA | GSV;
+    /// Talker IDs. Position sentences use the first one; GSA and GSV are
+    /// emitted for each.
+    std::vector<std::string> talkers = {"GP"};
+    unsigned satellites = 12; ///< satellites in view per talker
+    LineEnding lineEnding = CRLF;
+    double corruptChecksum = 0; ///< probability per sentence
+    double truncate = 0;        ///< probability per sentence
+    double overlongField = 0;   ///< probability per sentence
+  };
+
+  explicit NMEAGenerator(const Options &options)
+      : opt(options), rng(options.seed), epoch(0), lat(48.1173),
+        lng(11.5167), speed(12.5), course(84.4), altitude(545.4) {
+    if (opt.rateHz == 0)
+      opt.rateHz = 1;
+    if (opt.slowRateHz == 0 || opt.slowRateHz > opt.rateHz)
+      opt.slowRateHz = opt.rateHz;
+    if (opt.talkers.empty())
+      opt.talkers.push_back("GP");
+  }
+
+  /// Append the sentences of the next epoch to out
+  void nextEpoch(std::string &out) {
+    unsigned ms = (unsigned)((uint64_t)(epoch % opt.rateHz) * 1000 /
+                             opt.rateHz);
+    unsigned long s = (unsigned long)(epoch / opt.rateHz);
+    centiseconds = ((s / 3600) % 24) * 1000000 + ((s / 60) % 60) * 10000 +
+                   (s % 60) * 100 + ms / 10;
+    day = 1 + (s / 86400) % 28;
+    move();
+
+    const std::string &talker = opt.talkers[0];
+    if (opt.sentences & RMC)
+      emit(out, talker + "RMC", &NMEAGenerator::rmc);
+    if (opt.sentences & GGA)
+      emit(out, talker + "GGA", &NMEAGenerator::gga);
+    if (opt.sentences & GNS)
+      emit(out, talker + "GNS", &NMEAGenerator::gns);
+    if (opt.sentences & GLL)
+      emit(out, talker + "GLL", &NMEAGenerator::gll);
+    if (opt.sentences & VTG)
+      emit(out, talker + "VTG", &NMEAGenerator::vtg);
+
+    unsigned slowEvery = opt.rateHz / opt.slowRateHz;
+    if (epoch % slowEvery == 0) {
+      for (size_t t = 0; t < opt.talkers.size(); ++t) {
+        constellation = (unsigned)t;
+        if (opt.sentences & GSA)
+          emit(out, opt.talkers[t] + "GSA", &NMEAGenerator::gsa);
+        if (opt.sentences & GSV) {
+          unsigned messages = (opt.satellites + 3) / 4;
+          if (messages == 0)
+            messages = 1;
+          for (gsvMessage = 1; gsvMessage <= messages; ++gsvMessage)
+            emit(out, opt.talkers[t] + "GSV", &NMEAGenerator::gsv);
+        }
+      }
+      if (opt.sentences & GST)
+        emit(out, talker + "GST", &NMEAGenerator::gst);
+      if (opt.sentences & ZDA)
+        emit(out, talker + "ZDA", &NMEAGenerator::zda);
+    }
+    ++epoch;
+  }
+
+  /// Append epochs to out until it has grown by at least bytes
+  void generate(std::string &out, size_t bytes) {
+    size_t target = out.size() + bytes;
+    while (out.size() < target)
+      nextEpoch(out);
+  }
+
+  /// Build a stream covering the given number of seconds
+  std::string seconds(unsigned count) {
+    std::string out;
+    for (unsigned long e = 0; e < (unsigned long)count * opt.rateHz; ++e)
+      nextEpoch(out);
+    return out;
+  }
+
+private:
+  typedef void (NMEAGenerator::*Body)(std::string &);
+
+  Options opt;
+  Random rng;
+  unsigned long epoch;
+  unsigned long centiseconds;
+  unsigned day;
+  unsigned constellation, gsvMessage;
+  double lat, lng, speed, course, altitude;
+  std::string body;
+
+  // Formatting helpers; snprintf is far too slow for gigabyte streams
+
+  static void appendUInt(std::string &out, unsigned long v,
+                         unsigned width = 0) {
+    char buf[24];
+    unsigned n = 0;
+    do {
+      buf[n++] = (char)('0' + v % 10);
+      v /= 10;
+    } while (v);
+    while (n < width)
+      buf[n++] = '0';
+    while (n)
+      out += buf[--n];
+  }
+
+  static void appendFixed(std::string &out, double v, unsigned decimals,
+                          unsigned width = 0) {
+    if (v < 0) {
+      out += '-';
+      v = -v;
+    }
+    unsigned long scale = 1;
+    for (unsigned i = 0; i < decimals; ++i)
+      scale *= 10;
+    unsigned long fixed = (unsigned long)(v * scale + 0.5);
+    appendUInt(out, fixed / scale, width);
+    if (decimals) {
+      out += '.';
+      appendUInt(out, fixed % scale, decimals);
+    }
+  }
+
+  void appendTime(std::string &out) {
+    appendUInt(out, centiseconds / 100, 6);
+    out += '.';
+    appendUInt(out, centiseconds % 100, 2);
+  }
+
+  // ddmm.mmmmm plus hemisphere
+  void appendDegrees(std::string &out, double degrees, unsigned degWidth,
+                     char positive, char negative) {
+    double a = degrees < 0 ? -degrees : degrees;
+    unsigned whole = (unsigned)a;
+    appendUInt(out, whole, degWidth);
+    appendFixed(out, (a - whole) * 60, 5, 2);
+    out += ',';
+    out += degrees < 0 ? negative : positive;
+  }
+
+  void appendLatLng(std::string &out) {
+    appendDegrees(out, lat, 2, 'N', 'S');
+    out += ',';
+    appendDegrees(out, lng, 3, 'E', 'W');
+  }
+
+  void move() {
+    course += (double)rng.below(200) / 100 - 1;
+    if (course < 0)
+      course += 360;
+    if (course >= 360)
+      course -= 360;
+    speed += (double)rng.below(100) / 100 - 0.5;
+    if (speed < 0)
+      speed = 0;
+    double step = speed * 0.514444 / opt.rateHz / 111320;
+    lat += step * (course < 90 || course > 270 ? 1 : -1) * 0.7;
+    lng += step * (course < 180 ? 1 : -1) * 0.7;
+    altitude += (double)rng.below(100) / 100 - 0.5;
+  }
+
+  void rmc(std::string &out) {
+    appendTime(out);
+    out += ",A,";
+    appendLatLng(out);
+    out += ',';
+    appendFixed(out, speed, 2);
+    out += ',';
+    appendFixed(out, course, 1);
+    out += ',';
+    appendUInt(out, day, 2);
+    out += "0624,003.1,W,A";
+  }
+
+  void gga(std::string &out) {
+    appendTime(out);
+    out += ',';
+    appendLatLng(out);
+    out += ",1,";
+    appendUInt(out, opt.satellites < 12 ? opt.satellites : 12, 2);
+    out += ',';
+    appendFixed(out, 0.8 + rng.below(10) / 10.0, 1);
+    out += ',';
+    appendFixed(out, altitude, 1);
+    out += ",M,46.9,M,,";
+  }
+
+  void gns(std::string &out) {
+    appendTime(out);
+    out += ',';
+    appendLatLng(out);
+    out += ',';
+    for (size_t i = 0; i < opt.talkers.size(); ++i)
+      out += 'A';
+    out += ',';
+    appendUInt(out, opt.satellites < 99 ? opt.satellites : 99, 2);
+    out += ',';
+    appendFixed(out, 0.8 + rng.below(10) / 10.0, 1);
+    out += ',';
+    appendFixed(out, altitude, 1);
+    out += ",46.9,,";
+  }
+
+  void gll(std::string &out) {
+    appendLatLng(out);
+    out += ',';
+    appendTime(out);
+    out += ",A,A";
+  }
+
+  void vtg(std::string &out) {
+    appendFixed(out, course, 1);
+    out += ",T,,M,";
+    appendFixed(out, speed, 2);
+    out += ",N,";
+    appendFixed(out, speed * 1.852, 2);
+    out += ",K,A";
+  }
+
+  unsigned prn(unsigned i) const { return 1 + constellation * 32 + i; }
+
+  void gsa(std::string &out) {
+    out += "A,3";
+    for (unsigned i = 0; i < 12; ++i) {
+      out += ',';
+      if (i < opt.satellites && rng.below(4))
+        appendUInt(out, prn(i), 2);
+    }
+    out += ',';
+    appendFixed(out, 1.5 + rng.below(10) / 10.0, 1);
+    out += ',';
+    appendFixed(out, 0.8 + rng.below(10) / 10.0, 1);
+    out += ',';
+    appendFixed(out, 1.2 + rng.below(10) / 10.0, 1);
+  }
+
+  void gsv(std::string &out) {
+    unsigned messages = (opt.satellites + 3) / 4;
+    appendUInt(out, messages ? messages : 1);
+    out += ',';
+    appendUInt(out, gsvMessage);
+    out += ',';
+    appendUInt(out, opt.satellites, 2);
+    for (unsigned i = (gsvMessage - 1) * 4;
+         i < opt.satellites && i < gsvMessage * 4; ++i) {
+      out += ',';
+      appendUInt(out, prn(i), 2);
+      out += ',';
+      appendUInt(out, (prn(i) * 37 + epoch / 600) % 90, 2);
+      out += ',';
+      appendUInt(out, (prn(i) * 101 + epoch / 300) % 360, 3);
+      out += ',';
+      if (rng.below(8))
+        appendUInt(out, 20 + rng.below(30), 2);
+    }
+  }
+
+  void gst(std::string &out) {
+    appendTime(out);
+    for (unsigned i = 0; i < 7; ++i) {
+      out += ',';
+      appendFixed(out, rng.below(500) / 100.0, 2);
+    }
+  }
+
+  void zda(std::string &out) {
+    appendTime(out);
+    out += ',';
+    appendUInt(out, day, 2);
+    out += ",06,2024,00,00";
+  }
+
+  void emit(std::string &out, const std::string &address, Body fill) {
+    body.assign(address);
+    body += ',';
+    (this->*fill)(body);
+
+    if (rng.chance(opt.overlongField)) {
+      // Stretch one field well past _GPS_MAX_FIELD_SIZE
+      size_t comma = body.find(',', 1 + rng.below((unsigned)body.size()));
+      if (comma == std::string::npos)
+        comma = body.size();
+      body.insert(comma, 16 + rng.below(24), (char)('0' + rng.below(10)));
+    }
+
+    size_t start = out.size();
+    appendSentence(out, body);
+    out.resize(out.size() - 2); // line ending is added below
+
+    if (rng.chance(opt.corruptChecksum))
+      out[out.size() - 1] = out[out.size() - 1] == '0' ? '1' : '0';
+    if (rng.chance(opt.truncate))
+      out.resize(start + 1 + rng.below((unsigned)(out.size() - start - 1)));
+
+    LineEnding ending = opt.lineEnding;
+    if (ending == MIXED)
+      ending = (LineEnding)rng.below(3);
+    if (ending == CRLF || ending == CR)
+      out += '\r';
+    if (ending == CRLF || ending == LF)
+      out += '\n';
+  }
+};
+
+} // namespace bench
+
+#endif // TINYGPS_BENCH_NMEA_GENERATOR_H
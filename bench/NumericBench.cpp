@@ -0,0 +1,159 @@
+// Throughput of the numeric field kernels, per NMEA field type.
+//
+// Each field type is parsed with the TinyGPSNumeric SWAR kernels and with
+// the atol()/isdigit() implementation they replaced, so the two can be
+// compared side by side. The kernels are given the end of each field, as
+// TinyGPSField gives them the length it already knows.
+
+#include "TinyGPSNumeric.h"
+
+#include <benchmark/benchmark.h>
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace {
+
+// Representative values for each field type, as they appear on the wire
+const char *const timeFields[] = {"123519.00", "000001.50", "235959.99",
+                                  "101010.10"};
+const char *const latitudeFields[] = {"4807.038123", "3751.65", "0000.0001",
+                                      "8959.9999999"};
+const char *const longitudeFields[] = {"01131.000456", "12224.1111",
+                                       "00000.00", "17959.9999999"};
+const char *const speedFields[] = {"022.4", "0.004", "123.45", "5"};
+const char *const altitudeFields[] = {"545.4", "-12.7", "8848.86", "0.0"};
+const char *const satelliteFields[] = {"08", "12", "4", "24"};
+const char *const dateFields[] = {"230394", "010100", "311299", "150624"};
+
+int32_t atolParseDecimal(const char *term) {
+  bool negative = *term == '-';
+  if (negative)
+    ++term;
+  int32_t ret = 100 * (int32_t)atol(term);
+  while (isdigit(*term))
+    ++term;
+  if (*term == '.' && isdigit(term[1])) {
+    ret += 10 * (term[1] - '0');
+    if (isdigit(term[2]))
+      ret += term[2] - '0';
+  }
+  return negative ? -ret : ret;
+}
+
+void atolParseDegrees(const char *term, uint16_t &deg, uint32_t &billionths) {
+  uint32_t leftOfDecimal = (uint32_t)atol(term);
+  uint16_t minutes = (uint16_t)(leftOfDecimal % 100);
+  uint32_t multiplier = 10000000UL;
+  uint32_t tenMillionthsOfMinutes = minutes * multiplier;
+  deg = (uint16_t)(leftOfDecimal / 100);
+  while (isdigit(*term))
+    ++term;
+  if (*term == '.')
+    while (isdigit(*++term)) {
+      multiplier /= 10;
+      tenMillionthsOfMinutes += (*term - '0') * multiplier;
+    }
+  billionths = (5 * tenMillionthsOfMinutes + 1) / 3;
+}
+
+template <size_t N>
+void setCounters(benchmark::State &state, const char *const (&fields)[N]) {
+  size_t bytes = 0;
+  for (const char *f : fields)
+    bytes += strlen(f);
+  state.SetItemsProcessed(state.iterations() * N);
+  state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+// The fields with their ends, found once outside the timed loop
+template <size_t N> struct Ranges {
+  const char *begin[N], *end[N];
+  explicit Ranges(const char *const (&fields)[N]) {
+    for (size_t i = 0; i < N; ++i) {
+      begin[i] = fields[i];
+      end[i] = fields[i] + strlen(fields[i]);
+    }
+  }
+};
+
+template <size_t N>
+void decimalSWAR(benchmark::State &state, const char *const (&fields)[N]) {
+  Ranges<N> r(fields);
+  for (auto _ : state)
+    for (size_t i = 0; i < N; ++i)
+      benchmark::DoNotOptimize(TinyGPSNumeric::parseDecimal(r.begin[i],
+                                                            r.end[i]));
+  setCounters(state, fields);
+}
+
+template <size_t N>
+void decimalAtol(benchmark::State &state, const char *const (&fields)[N]) {
+  for (auto _ : state)
+    for (const char *f : fields)
+      benchmark::DoNotOptimize(atolParseDecimal(f));
+  setCounters(state, fields);
+}
+
+template <size_t N>
+void degreesSWAR(benchmark::State &state, const char *const (&fields)[N]) {
+  Ranges<N> r(fields);
+  uint16_t deg;
+  uint32_t billionths;
+  for (auto _ : state)
+    for (size_t i = 0; i < N; ++i) {
+      TinyGPSNumeric::parseDegrees(r.begin[i], r.end[i], deg, billionths);
+      benchmark::DoNotOptimize(deg);
+      benchmark::DoNotOptimize(billionths);
+    }
+  setCounters(state, fields);
+}
+
+template <size_t N>
+void degreesAtol(benchmark::State &state, const char *const (&fields)[N]) {
+  uint16_t deg;
+  uint32_t billionths;
+  for (auto _ : state)
+    for (const char *f : fields) {
+      atolParseDegrees(f, deg, billionths);
+      benchmark::DoNotOptimize(deg);
+      benchmark::DoNotOptimize(billionths);
+    }
+  setCounters(state, fields);
+}
+
+template <size_t N>
+void unsignedSWAR(benchmark::State &state, const char *const (&fields)[N]) {
+  Ranges<N> r(fields);
+  for (auto _ : state)
+    for (size_t i = 0; i < N; ++i) {
+      const char *p = r.begin[i];
+      benchmark::DoNotOptimize(TinyGPSNumeric::parseUnsigned(p, r.end[i]));
+    }
+  setCounters(state, fields);
+}
+
+template <size_t N>
+void unsignedAtol(benchmark::State &state, const char *const (&fields)[N]) {
+  for (auto _ : state)
+    for (const char *f : fields)
+      benchmark::DoNotOptimize(atol(f));
+  setCounters(state, fields);
+}
+
+} // namespace
+
+BENCHMARK_CAPTURE(decimalSWAR, time, timeFields);
+BENCHMARK_CAPTURE(decimalAtol, time, timeFields);
+BENCHMARK_CAPTURE(degreesSWAR, latitude, latitudeFields);
+BENCHMARK_CAPTURE(degreesAtol, latitude, latitudeFields);
+BENCHMARK_CAPTURE(degreesSWAR, longitude, longitudeFields);
+BENCHMARK_CAPTURE(degreesAtol, longitude, longitudeFields);
+BENCHMARK_CAPTURE(decimalSWAR, speed, speedFields);
+BENCHMARK_CAPTURE(decimalAtol, speed, speedFields);
+BENCHMARK_CAPTURE(decimalSWAR, altitude, altitudeFields);
+BENCHMARK_CAPTURE(decimalAtol, altitude, altitudeFields);
+BENCHMARK_CAPTURE(unsignedSWAR, satellites, satelliteFields);
+BENCHMARK_CAPTURE(unsignedAtol, satellites, satelliteFields);
+BENCHMARK_CAPTURE(unsignedSWAR, date, dateFields);
+BENCHMARK_CAPTURE(unsignedAtol, date, dateFields);
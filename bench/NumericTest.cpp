@@ -0,0 +1,176 @@
+// Tests that the TinyGPSNumeric SWAR kernels parse numbers as the atol()
+// implementation they replaced did, and never read past the end of their
+// input.
+
+#include "NMEAGenerator.h"
+#include "TinyGPSNumeric.h"
+
+#include <ctype.h>
+#include <gtest/gtest.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+// The parseDecimal() and parseDegrees() of TinyGPS++ 1.0
+int32_t atolParseDecimal(const char *term) {
+  bool negative = *term == '-';
+  if (negative)
+    ++term;
+  int32_t ret = 100 * (int32_t)atol(term);
+  while (isdigit(*term))
+    ++term;
+  if (*term == '.' && isdigit(term[1])) {
+    ret += 10 * (term[1] - '0');
+    if (isdigit(term[2]))
+      ret += term[2] - '0';
+  }
+  return negative ? -ret : ret;
+}
+
+void atolParseDegrees(const char *term, uint16_t &deg, uint32_t &billionths) {
+  uint32_t leftOfDecimal = (uint32_t)atol(term);
+  uint16_t minutes = (uint16_t)(leftOfDecimal % 100);
+  uint32_t multiplier = 10000000UL;
+  uint32_t tenMillionthsOfMinutes = minutes * multiplier;
+  deg = (uint16_t)(leftOfDecimal / 100);
+  while (isdigit(*term))
+    ++term;
+  if (*term == '.')
+    while (isdigit(*++term)) {
+      multiplier /= 10;
+      tenMillionthsOfMinutes += (*term - '0') * multiplier;
+    }
+  billionths = (5 * tenMillionthsOfMinutes + 1) / 3;
+}
+
+// Random text of the characters numeric fields are made of, with at most
+// seven digits in a row so 100 times a whole part cannot overflow 32 bits
+std::string randomNumber(bench::Random &rng, const char *alphabet) {
+  std::string s;
+  unsigned length = rng.below(14);
+  unsigned run = 0;
+  for (unsigned i = 0; i < length; ++i) {
+    char c = alphabet[rng.below((uint32_t)strlen(alphabet))];
+    run = isdigit(c) ? run + 1 : 0;
+    if (run > 7)
+      c = '.';
+    s += c;
+  }
+  return s;
+}
+
+const char *const wellFormed = "0123456789012345678901234567890123456789.-";
+const char *const anything = "0123456789 \t\r+-.x";
+
+TEST(NumericTest, UnsignedMatchesAtol) {
+  bench::Random rng(1);
+  for (int i = 0; i < 200000; ++i) {
+    std::string s = randomNumber(rng, anything);
+    const char *p = s.c_str();
+    EXPECT_EQ((uint32_t)atol(s.c_str()), TinyGPSNumeric::parseUnsigned(p))
+        << '"' << s << '"';
+  }
+}
+
+TEST(NumericTest, DecimalWholePartMatchesAtol) {
+  bench::Random rng(2);
+  for (int i = 0; i < 200000; ++i) {
+    std::string s = randomNumber(rng, anything);
+    EXPECT_EQ(atol(s.c_str()), TinyGPSNumeric::parseDecimal(s.c_str()) / 100)
+        << '"' << s << '"';
+  }
+}
+
+TEST(NumericTest, DecimalMatchesAtolImplementation) {
+  bench::Random rng(3);
+  for (int i = 0; i < 200000; ++i) {
+    std::string s = randomNumber(rng, wellFormed);
+    // A '-' after the first character stops both parsers; only the old
+    // one read "--5" as 5
+    if (s.size() > 1 && s[0] == '-' && s[1] == '-')
+      continue;
+    EXPECT_EQ(atolParseDecimal(s.c_str()),
+              TinyGPSNumeric::parseDecimal(s.c_str()))
+        << '"' << s << '"';
+  }
+}
+
+TEST(NumericTest, DecimalAcceptsWhitespaceAndSign) {
+  EXPECT_EQ(1234, TinyGPSNumeric::parseDecimal(" 12.34"));
+  EXPECT_EQ(1234, TinyGPSNumeric::parseDecimal("+12.34"));
+  EXPECT_EQ(1234, TinyGPSNumeric::parseDecimal("\t\r\n +12.34"));
+  EXPECT_EQ(-50, TinyGPSNumeric::parseDecimal("  -0.5"));
+  EXPECT_EQ(0, TinyGPSNumeric::parseDecimal("- 5"));
+  EXPECT_EQ(0, TinyGPSNumeric::parseDecimal("+-5"));
+  EXPECT_EQ(0, TinyGPSNumeric::parseDecimal(""));
+}
+
+TEST(NumericTest, Thousandths) {
+  const struct {
+    const char *text;
+    int32_t value;
+  } cases[] = {{"0.006", 6},       {"0.0239", 23},   {"12", 12000},
+               {"1.5", 1500},      {"273.6", 273600}, {"-0.02", -20},
+               {" +2.10", 2100},   {".5", 500},      {"7.", 7000},
+               {"- 5", 0},         {"", 0}};
+  for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+    const char *text = cases[i].text;
+    EXPECT_EQ(cases[i].value,
+              TinyGPSNumeric::parseThousandths(text, text + strlen(text)))
+        << '"' << text << '"';
+  }
+  const char *text = "0.0239";
+  EXPECT_EQ(20, TinyGPSNumeric::parseThousandths(text, text + 4));
+}
+
+TEST(NumericTest, DegreesMatchAtolImplementation) {
+  bench::Random rng(4);
+  for (int i = 0; i < 200000; ++i) {
+    std::string s = randomNumber(rng, "0123456789012345678901234567890123.");
+    uint16_t deg, wantDeg;
+    uint32_t billionths, wantBillionths;
+    TinyGPSNumeric::parseDegrees(s.c_str(), deg, billionths);
+    atolParseDegrees(s.c_str(), wantDeg, wantBillionths);
+    EXPECT_EQ(wantDeg, deg) << '"' << s << '"';
+    EXPECT_EQ(wantBillionths, billionths) << '"' << s << '"';
+  }
+}
+
+TEST(NumericTest, DegreesSkipWhitespaceAndSign) {
+  uint16_t deg;
+  uint32_t billionths;
+  TinyGPSNumeric::parseDegrees(" +4807.038", deg, billionths);
+  EXPECT_EQ(48, deg);
+  EXPECT_EQ(117300000u, billionths);
+  TinyGPSNumeric::parseDegrees("-4807.038", deg, billionths);
+  EXPECT_EQ(48, deg);
+  EXPECT_EQ(117300000u, billionths);
+}
+
+// Each number sits at the very end of its own allocation, so a read past
+// end would leave it; the bytes past end in the text are digits that must
+// not be taken
+TEST(NumericTest, StopsAtEnd) {
+  const std::string text = "4807.0381234567890";
+  for (size_t n = 0; n <= text.size(); ++n) {
+    std::vector<char> buffer(text.begin(), text.begin() + n);
+    const char *begin = buffer.data(), *end = begin + n;
+    std::string terminated(text, 0, n);
+
+    const char *p = begin;
+    EXPECT_EQ((uint32_t)atol(terminated.c_str()),
+              TinyGPSNumeric::parseUnsigned(p, end));
+    EXPECT_EQ(atolParseDecimal(terminated.c_str()),
+              TinyGPSNumeric::parseDecimal(begin, end));
+    uint16_t deg, wantDeg;
+    uint32_t billionths, wantBillionths;
+    TinyGPSNumeric::parseDegrees(begin, end, deg, billionths);
+    atolParseDegrees(terminated.c_str(), wantDeg, wantBillionths);
+    EXPECT_EQ(wantDeg, deg) << n;
+    EXPECT_EQ(wantBillionths, billionths) << n;
+  }
+}
+
+} // namespace
@@ -0,0 +1,129 @@
+// Multi-stream benchmarks: thousands of receivers fed round-robin in
+// serial-read-sized chunks, through one TinyGPSPool against one TinyGPSPlus
+// (with its own TinyGPSCustom objects) per stream. Reports aggregate bytes/s,
+// sentences/s and the memory each stream costs.
+
+#include "NMEAGenerator.h"
+#include "TinyGPS++.h"
+#include "TinyGPSPool.h"
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+const size_t chunkSize = 256;
+
+const std::string &corpus() {
+  static std::string c;
+  if (c.empty()) {
+    bench::NMEAGenerator::Options options;
+    options.rateHz = 10;
+    options.talkers = {"GP", "GL"};
+    c = bench::NMEAGenerator(options).seconds(600);
+  }
+  return c;
+}
+
+// The satellite tracker custom fields of macro_bench
+template <class Register> void trackerFields(Register add) {
+  for (int i = 1; i <= 19; ++i) {
+    add("GPGSV", i);
+    add("GLGSV", i);
+  }
+  for (int i = 1; i <= 17; ++i)
+    add("GPGSA", i);
+  for (int i = 10; i <= 12; ++i)
+    add("GPRMC", i);
+  for (int i = 10; i <= 14; ++i)
+    add("GPGGA", i);
+}
+
+// Stream i reads the corpus starting at its own offset, so the streams are
+// not in lockstep
+struct Cursors {
+  std::vector<size_t> offset;
+
+  explicit Cursors(size_t streams) : offset(streams) {
+    size_t size = corpus().size();
+    for (size_t i = 0; i < streams; ++i)
+      offset[i] = (i * 7919 * chunkSize) % (size - chunkSize);
+  }
+
+  const char *next(size_t stream) {
+    const std::string &c = corpus();
+    size_t &o = offset[stream];
+    if (o + chunkSize > c.size())
+      o = 0;
+    const char *chunk = c.data() + o;
+    o += chunkSize;
+    return chunk;
+  }
+};
+
+void setCounters(benchmark::State &state, size_t streams,
+                 size_t bytesPerStream) {
+  size_t bytes = state.iterations() * streams * chunkSize;
+  state.SetBytesProcessed(bytes);
+  state.counters["sentences"] = benchmark::Counter(
+      (double)bytes * bench::countSentences(corpus()) / corpus().size(),
+      benchmark::Counter::kIsRate);
+  state.counters["bytes_per_stream"] = (double)bytesPerStream;
+}
+
+// range(0): streams, range(1): 1 to register the tracker's custom fields.
+// One iteration feeds one chunk to every stream.
+void BM_PoolFeed(benchmark::State &state) {
+  size_t streams = state.range(0);
+  TinyGPSPoolConfig config;
+  if (state.range(1))
+    trackerFields([&](const char *name, int term) {
+      config.addCustom(name, term);
+    });
+  TinyGPSPool pool(config, streams);
+  Cursors cursors(streams);
+
+  for (auto _ : state)
+    for (size_t i = 0; i < streams; ++i)
+      benchmark::DoNotOptimize(pool.feed(i, cursors.next(i), chunkSize));
+  setCounters(state, streams, pool.bytesPerStream());
+}
+
+// The same load through one TinyGPSPlus per stream
+void BM_InstanceFeed(benchmark::State &state) {
+  size_t streams = state.range(0);
+  std::vector<std::unique_ptr<TinyGPSPlus>> gps(streams);
+  std::vector<std::unique_ptr<TinyGPSCustom[]>> customs(streams);
+  size_t customCount = 0;
+  if (state.range(1))
+    trackerFields([&](const char *, int) { ++customCount; });
+  for (size_t i = 0; i < streams; ++i) {
+    gps[i].reset(new TinyGPSPlus);
+    customs[i].reset(new TinyGPSCustom[customCount]);
+    size_t n = 0;
+    if (state.range(1))
+      trackerFields([&](const char *name, int term) {
+        customs[i][n++].begin(*gps[i], name, term);
+      });
+  }
+  Cursors cursors(streams);
+
+  for (auto _ : state)
+    for (size_t i = 0; i < streams; ++i)
+      benchmark::DoNotOptimize(gps[i]->encode(cursors.next(i), chunkSize));
+  setCounters(state, streams,
+              sizeof(TinyGPSPlus) + customCount * sizeof(TinyGPSCustom));
+}
+
+BENCHMARK(BM_PoolFeed)
+    ->ArgNames({"streams", "custom"})
+    ->ArgsProduct({{1000, 10000}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_InstanceFeed)
+    ->ArgNames({"streams", "custom"})
+    ->ArgsProduct({{1000, 10000}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,183 @@
+// Tests that every stream of a TinyGPSPool commits the fix and custom
+// fields a TinyGPSPlus fed the same chunks commits.
+
+#include "NMEAGenerator.h"
+#include "TinyGPS++.h"
+#include "TinyGPSPool.h"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Custom fields registered with both parsers, as in pool_bench
+struct Custom {
+  const char *sentence;
+  int term;
+};
+
+std::vector<Custom> customFields() {
+  std::vector<Custom> fields;
+  for (int i = 1; i <= 19; ++i) {
+    fields.push_back({"GPGSV", i});
+    fields.push_back({"GLGSV", i});
+  }
+  for (int i = 1; i <= 17; ++i)
+    fields.push_back({"GPGSA", i});
+  for (int i = 10; i <= 12; ++i)
+    fields.push_back({"GPRMC", i});
+  for (int i = 10; i <= 14; ++i)
+    fields.push_back({"GPGGA", i});
+  return fields;
+}
+
+std::string noisyStream(uint32_t seed, double noise) {
+  bench::NMEAGenerator::Options options;
+  options.seed = seed;
+  options.rateHz = 5;
+  options.sentences = ~0u;
+  options.talkers = {"GP", "GL", "GN"};
+  options.lineEnding = bench::NMEAGenerator::MIXED;
+  options.corruptChecksum = noise;
+  options.truncate = noise;
+  options.overlongField = noise;
+  return bench::NMEAGenerator(options).seconds(60);
+}
+
+// Compares the committed values and valid masks. The pool accumulates
+// updated until clearUpdated(), and commitTime is a clock reading.
+void expectSameFix(const TinyGPSFix &want, const TinyGPSFix &got,
+                   size_t stream) {
+  ASSERT_EQ(want.valid, got.valid) << "stream " << stream;
+  if (want.valid & TinyGPSFix::LOCATION) {
+    EXPECT_EQ(want.latitude, got.latitude) << "stream " << stream;
+    EXPECT_EQ(want.longitude, got.longitude) << "stream " << stream;
+  }
+  if (want.valid & TinyGPSFix::DATE) {
+    EXPECT_EQ(want.date, got.date) << "stream " << stream;
+  }
+  if (want.valid & TinyGPSFix::TIME) {
+    EXPECT_EQ(want.time, got.time) << "stream " << stream;
+  }
+  if (want.valid & TinyGPSFix::SPEED) {
+    EXPECT_EQ(want.speed, got.speed) << "stream " << stream;
+  }
+  if (want.valid & TinyGPSFix::COURSE) {
+    EXPECT_EQ(want.course, got.course) << "stream " << stream;
+  }
+  if (want.valid & TinyGPSFix::ALTITUDE) {
+    EXPECT_EQ(want.altitude, got.altitude) << "stream " << stream;
+  }
+  if (want.valid & TinyGPSFix::SATELLITES) {
+    EXPECT_EQ(want.satellites, got.satellites) << "stream " << stream;
+  }
+  if (want.valid & TinyGPSFix::HDOP) {
+    EXPECT_EQ(want.hdop, got.hdop) << "stream " << stream;
+  }
+}
+
+// Feeds each stream to the pool and to its own TinyGPSPlus in the same
+// random chunks, interleaving the streams, and compares them after every
+// chunk
+void expectSameAsTinyGPSPlus(const std::vector<std::string> &streams,
+                             uint32_t seed, size_t maxChunk) {
+  std::vector<Custom> fields = customFields();
+  TinyGPSPoolConfig config;
+  std::vector<int> handles;
+  for (size_t f = 0; f < fields.size(); ++f)
+    handles.push_back(config.addCustom(fields[f].sentence, fields[f].term));
+  TinyGPSPool pool(config, streams.size());
+
+  std::vector<TinyGPSPlus> gps(streams.size());
+  std::vector<std::vector<TinyGPSCustom>> customs(streams.size());
+  for (size_t i = 0; i < streams.size(); ++i) {
+    customs[i].resize(fields.size());
+    for (size_t f = 0; f < fields.size(); ++f)
+      customs[i][f].begin(gps[i], fields[f].sentence, fields[f].term);
+  }
+
+  bench::Random rng(seed);
+  std::vector<size_t> offset(streams.size());
+  for (bool fed = true; fed;) {
+    fed = false;
+    for (size_t i = 0; i < streams.size(); ++i) {
+      const std::string &s = streams[i];
+      if (offset[i] == s.size())
+        continue;
+      size_t n = 1 + rng.below((uint32_t)maxChunk);
+      if (n > s.size() - offset[i])
+        n = s.size() - offset[i];
+      const char *chunk = s.data() + offset[i];
+      ASSERT_EQ(gps[i].encode(chunk, n), pool.feed(i, chunk, n));
+      offset[i] += n;
+      fed = true;
+
+      expectSameFix(gps[i].fix(), pool.fix(i), i);
+      for (size_t f = 0; f < fields.size(); ++f)
+        ASSERT_STREQ(customs[i][f].value(), pool.custom(i, handles[f]))
+            << "stream " << i << " " << fields[f].sentence << " term "
+            << fields[f].term;
+    }
+  }
+
+  for (size_t i = 0; i < streams.size(); ++i) {
+    EXPECT_EQ(gps[i].passedChecksum(), pool.passedChecksum(i));
+    EXPECT_EQ(gps[i].failedChecksum(), pool.failedChecksum(i));
+  }
+}
+
+TEST(PoolTest, CleanStreams) {
+  std::vector<std::string> streams;
+  for (uint32_t i = 0; i < 4; ++i)
+    streams.push_back(noisyStream(1 + i, 0));
+  expectSameAsTinyGPSPlus(streams, 1, 300);
+}
+
+TEST(PoolTest, NoisyStreams) {
+  std::vector<std::string> streams;
+  for (uint32_t i = 0; i < 6; ++i)
+    streams.push_back(noisyStream(10 + i, 0.05 * i));
+  expectSameAsTinyGPSPlus(streams, 2, 1);
+  expectSameAsTinyGPSPlus(streams, 3, 200);
+}
+
+// A failed sentence stages nothing that a later sentence with empty terms
+// could commit, on either parser
+TEST(PoolTest, FailedSentenceStagesNothing) {
+  std::string stream;
+  bench::appendSentence(stream, "GPRMC,123519,A,4807.038,N,01131.000,E,022.4,"
+                                "084.4,230394,003.1,W");
+  stream += "$GPRMC,123520,A,5107.038,S,00131.000,W,010.0,180.0,240394,"
+            "003.1,W*00\r\n";
+  bench::appendSentence(stream, "GPRMC,123521,A,,,,,,,,003.1,W");
+  // Custom fields past the end of a short sentence
+  bench::appendSentence(stream, "GPGGA,123522,4807.038,N,01131.000,E,1,08,"
+                                "0.9,545.4,M,46.9,M,,");
+  stream += "$GPGGA,123523,4807.038,N,01131.000,E,1,08,0.9,545.4,X,99.9,X,"
+            "1,2*00\r\n";
+  bench::appendSentence(stream, "GPGGA,123524,4807.038,N,01131.000,E,1,08");
+  expectSameAsTinyGPSPlus(std::vector<std::string>(3, stream), 4, 40);
+}
+
+// Term numbers are counted in eight bits
+TEST(PoolTest, AddCustomRejectsTermsPast255) {
+  TinyGPSPoolConfig config;
+  EXPECT_EQ(-1, config.addCustom("GPGSA", 256));
+  EXPECT_EQ(-1, config.addCustom("GPGSA", -1));
+  EXPECT_EQ(0, config.addCustom("GPGSA", 255));
+  EXPECT_EQ(1, config.addCustom("GPGSA", 1));
+  EXPECT_EQ(2u, config.customCount());
+
+  std::string body = "GPGSA";
+  for (int i = 1; i <= 255; ++i)
+    body += "," + std::to_string(i);
+  std::string stream;
+  bench::appendSentence(stream, body);
+  TinyGPSPool pool(config, 1);
+  pool.feed(0, stream.data(), stream.size());
+  EXPECT_STREQ("255", pool.custom(0, 0));
+  EXPECT_STREQ("1", pool.custom(0, 1));
+}
+
+} // namespace
@@ -0,0 +1,129 @@
+// Tests that TinyGPSFixPublisher readers never load half of one fix and
+// half of another while the writer publishes, and see fixes in order.
+
+#include "NMEAGenerator.h"
+#include "TinyGPSFixPublisher.h"
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// The k-th fix published, every field derived from k so a reader can tell
+// a torn copy from a whole one
+TinyGPSFix numbered(uint32_t k) {
+  TinyGPSFix fix = {};
+  fix.latitude = (int64_t)k * 3;
+  fix.longitude = -(int64_t)k;
+  fix.date = k + 1;
+  fix.time = k;
+  fix.speed = (int32_t)k * 5;
+  fix.altitude = -(int32_t)k;
+  fix.hdop = (int32_t)k;
+  fix.commitTime = k * 7;
+  fix.satellites = (uint16_t)k;
+  return fix;
+}
+
+bool isWhole(const TinyGPSFix &fix) {
+  uint32_t k = fix.time;
+  TinyGPSFix want = numbered(k);
+  return fix.latitude == want.latitude && fix.longitude == want.longitude &&
+         fix.date == want.date && fix.speed == want.speed &&
+         fix.altitude == want.altitude && fix.hdop == want.hdop &&
+         fix.commitTime == want.commitTime &&
+         fix.satellites == want.satellites;
+}
+
+TEST(PublisherTest, NeverTears) {
+  const uint32_t minFixes = 1000000, maxFixes = 100000000;
+  const uint64_t minChanges = 300;
+  const int readerCount = 3;
+  TinyGPSFixPublisher publisher;
+  std::atomic<bool> stop(false);
+  std::atomic<uint32_t> torn(0), outOfOrder(0), mislabelled(0);
+  std::atomic<uint64_t> changes(0);
+
+  std::vector<std::thread> readers;
+  for (int r = 0; r < readerCount; ++r)
+    readers.emplace_back([&] {
+      uint32_t last = 0;
+      bool done = false;
+      while (!done) {
+        done = stop.load();
+        TinyGPSFix fix;
+        uint32_t version = publisher.load(fix);
+        if (version == 0)
+          continue;
+        if (!isWhole(fix))
+          ++torn;
+        if (fix.time != version)
+          ++mislabelled;
+        if (version < last)
+          ++outOfOrder;
+        if (version != last)
+          ++changes;
+        last = version;
+      }
+    });
+
+  // Publish until the readers have raced the writer often enough. On a
+  // single core that takes many preemptions, some of them mid-publish.
+  uint32_t fixes = 0;
+  while (fixes < minFixes ||
+         (changes.load() < minChanges && fixes < maxFixes))
+    publisher.publish(numbered(++fixes));
+  stop = true;
+  for (size_t r = 0; r < readers.size(); ++r)
+    readers[r].join();
+
+  EXPECT_EQ(0u, torn.load());
+  EXPECT_EQ(0u, mislabelled.load());
+  EXPECT_EQ(0u, outOfOrder.load());
+  EXPECT_EQ(fixes, publisher.version());
+  EXPECT_TRUE(isWhole(publisher.load()));
+  EXPECT_EQ(fixes, publisher.load().time);
+  // The readers must have raced the writer for the test to mean anything
+  EXPECT_GE(changes.load(), minChanges);
+}
+
+TEST(PublisherTest, StartsAtZero) {
+  TinyGPSFixPublisher publisher;
+  TinyGPSFix fix;
+  EXPECT_EQ(0u, publisher.load(fix));
+  EXPECT_EQ(0u, publisher.version());
+  EXPECT_EQ(0u, fix.valid);
+  EXPECT_EQ(0, fix.latitude);
+}
+
+#if _GPS_MAX_LISTENERS > 0
+// An attached publisher holds the fix of the parser after every commit
+TEST(PublisherTest, AttachedPublishesEachCommit) {
+  TinyGPSPlus gps;
+  TinyGPSFixPublisher publisher;
+  ASSERT_TRUE(publisher.attach(gps));
+
+  std::string stream;
+  bench::appendSentence(stream, "GPRMC,123519,A,4807.038,N,01131.000,E,022.4,"
+                                "084.4,230394,003.1,W");
+  bench::appendSentence(stream, "GPGGA,123520,4807.040,N,01131.000,E,1,08,0.9,"
+                                "545.4,M,46.9,M,,");
+  for (size_t i = 0; i < stream.size(); ++i)
+    if (gps.encode(stream[i])) {
+      TinyGPSFix want = gps.fix(), got = publisher.load();
+      EXPECT_EQ(want.latitude, got.latitude);
+      EXPECT_EQ(want.time, got.time);
+      EXPECT_EQ(want.valid, got.valid);
+    }
+  EXPECT_EQ(2u, publisher.version());
+
+  publisher.detach();
+  gps.encode(stream.data(), stream.size());
+  EXPECT_EQ(2u, publisher.version());
+}
+#endif
+
+} // namespace
@@ -0,0 +1,174 @@
+// Log replay throughput: a 64 MiB recorded log replayed sequentially through
+// TinyGPSPlus, and in parallel through TinyGPSReplay with 1, 2, 4, ...
+// threads up to the number of cores. The same log is also read from a file
+// with getc(), with fread() and through the TinyGPSLogReader mapping, and
+// split into TinyGPSSentence field views.
+
+#include "NMEAGenerator.h"
+#include "TinyGPS++.h"
+#include "TinyGPSLogReader.h"
+#include "TinyGPSReplay.h"
+
+#include <benchmark/benchmark.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <thread>
+
+namespace {
+
+const std::string &recordedLog() {
+  static std::string c;
+  if (c.empty()) {
+    bench::NMEAGenerator::Options options;
+    options.rateHz = 10;
+    options.talkers = {"GP", "GL"};
+    options.corruptChecksum = 0.001;
+    options.truncate = 0.001;
+    bench::NMEAGenerator(options).generate(c, 64 << 20);
+  }
+  return c;
+}
+
+// The log written to a temporary file, removed at exit
+const char *logFile() {
+  static std::string path;
+  if (path.empty()) {
+    char name[] = "/tmp/tinygps_replay_XXXXXX";
+    int fd = mkstemp(name);
+    FILE *f = fdopen(fd, "wb");
+    fwrite(recordedLog().data(), 1, recordedLog().size(), f);
+    fclose(f);
+    path = name;
+    atexit([] { remove(path.c_str()); });
+  }
+  return path.c_str();
+}
+
+void setCounters(benchmark::State &state, uint64_t sentences) {
+  state.SetBytesProcessed(state.iterations() * recordedLog().size());
+  state.counters["sentences"] =
+      benchmark::Counter((double)sentences, benchmark::Counter::kIsRate);
+}
+
+void BM_SequentialEncode(benchmark::State &state) {
+  const std::string &data = recordedLog();
+  uint64_t sentences = 0;
+  for (auto _ : state) {
+    TinyGPSPlus gps;
+    sentences += gps.encode(data.data(), data.size());
+  }
+  setCounters(state, sentences);
+}
+BENCHMARK(BM_SequentialEncode)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+void countFix(const TinyGPSFix &fix, void *context) {
+  *(uint64_t *)context += fix.updated != 0;
+}
+
+void BM_ParallelReplay(benchmark::State &state) {
+  const std::string &data = recordedLog();
+  uint64_t sentences = 0, fixes = 0;
+  for (auto _ : state) {
+    TinyGPSReplay replay((unsigned)state.range(0));
+    replay.replay(data.data(), data.size(), countFix, &fixes);
+    sentences += replay.passedChecksum();
+  }
+  benchmark::DoNotOptimize(fixes);
+  setCounters(state, sentences);
+}
+
+void threadCounts(benchmark::internal::Benchmark *b) {
+  unsigned cores = std::thread::hardware_concurrency();
+  if (cores == 0)
+    cores = 1;
+  for (unsigned t = 1; t < cores; t *= 2)
+    b->Arg(t);
+  b->Arg(cores);
+}
+
+BENCHMARK(BM_ParallelReplay)
+    ->ArgName("threads")
+    ->Apply(threadCounts)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+void BM_FileGetc(benchmark::State &state) {
+  uint64_t sentences = 0;
+  for (auto _ : state) {
+    TinyGPSPlus gps;
+    FILE *f = fopen(logFile(), "rb");
+    for (int c; (c = getc(f)) != EOF;)
+      sentences += gps.encode((char)c);
+    fclose(f);
+  }
+  setCounters(state, sentences);
+}
+BENCHMARK(BM_FileGetc)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+void BM_FileRead(benchmark::State &state) {
+  uint64_t sentences = 0;
+  std::string buffer(64 << 10, '\0');
+  for (auto _ : state) {
+    TinyGPSPlus gps;
+    FILE *f = fopen(logFile(), "rb");
+    for (size_t n; (n = fread(&buffer[0], 1, buffer.size(), f)) > 0;)
+      sentences += gps.encode(buffer.data(), n);
+    fclose(f);
+  }
+  setCounters(state, sentences);
+}
+BENCHMARK(BM_FileRead)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+void BM_FileMapped(benchmark::State &state) {
+  uint64_t sentences = 0;
+  for (auto _ : state) {
+    TinyGPSPlus gps;
+    TinyGPSLogReader reader;
+    reader.open(logFile());
+    sentences += reader.encodeInto(gps);
+  }
+  setCounters(state, sentences);
+}
+BENCHMARK(BM_FileMapped)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Sentence slices straight from the mapping, checksum only
+void BM_MappedSentenceViews(benchmark::State &state) {
+  uint64_t sentences = 0;
+  for (auto _ : state) {
+    TinyGPSLogReader reader;
+    reader.open(logFile());
+    std::string_view sentence;
+    while (reader.nextSentence(sentence))
+      sentences += TinyGPSPlus::verifySentence(
+          sentence.data(), sentence.data() + sentence.size());
+  }
+  setCounters(state, sentences);
+}
+BENCHMARK(BM_MappedSentenceViews)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// Sentences from the mapping split into field views, reading the time of
+// each valid one
+void BM_MappedSentenceFields(benchmark::State &state) {
+  uint64_t sentences = 0;
+  uint32_t time = 0;
+  for (auto _ : state) {
+    TinyGPSLogReader reader;
+    reader.open(logFile());
+    TinyGPSSentence sentence;
+    while (reader.nextSentence(sentence))
+      if (sentence.isValid()) {
+        time ^= (uint32_t)sentence.term(1).toDecimal();
+        ++sentences;
+      }
+  }
+  benchmark::DoNotOptimize(time);
+  setCounters(state, sentences);
+}
+BENCHMARK(BM_MappedSentenceFields)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,277 @@
+// Tests that TinyGPSReplay, parsing chunks of a log in parallel, reports
+// exactly the fixes a TinyGPSPlus fed the same log sequentially commits,
+// whatever the thread count and chunk size.
+
+#include "NMEAGenerator.h"
+#include "TinyGPS++.h"
+#include "TinyGPSReplay.h"
+
+#include <gtest/gtest.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+void collect(const TinyGPSFix &fix, void *context) {
+  ((std::vector<TinyGPSFix> *)context)->push_back(fix);
+}
+
+// The fix of a TinyGPSPlus after every sentence that passes its checksum
+std::vector<TinyGPSFix> sequential(const std::string &stream,
+                                   uint32_t &failed) {
+  std::vector<TinyGPSFix> fixes;
+  TinyGPSPlus gps;
+  for (size_t i = 0; i < stream.size(); ++i)
+    if (gps.encode(stream[i]))
+      fixes.push_back(gps.fix());
+  failed = gps.failedChecksum();
+  return fixes;
+}
+
+// Compares the committed values and valid masks, which are what a replay
+// must reproduce. commitTime counts sentences in a replay rather than
+// milliseconds, and TinyGPSPlus keeps the updated mask of its latest commit
+// through sentences that commit none of these fields.
+void expectSameFix(const TinyGPSFix &want, const TinyGPSFix &got,
+                   size_t sentence) {
+  ASSERT_EQ(want.valid, got.valid) << "sentence " << sentence;
+  if (got.updated) {
+    ASSERT_EQ(want.updated, got.updated) << "sentence " << sentence;
+  }
+  if (want.valid & TinyGPSFix::LOCATION) {
+    ASSERT_EQ(want.latitude, got.latitude) << "sentence " << sentence;
+    ASSERT_EQ(want.longitude, got.longitude) << "sentence " << sentence;
+  }
+  if (want.valid & TinyGPSFix::DATE) {
+    ASSERT_EQ(want.date, got.date) << "sentence " << sentence;
+  }
+  if (want.valid & TinyGPSFix::TIME) {
+    ASSERT_EQ(want.time, got.time) << "sentence " << sentence;
+  }
+  if (want.valid & TinyGPSFix::SPEED) {
+    ASSERT_EQ(want.speed, got.speed) << "sentence " << sentence;
+  }
+  if (want.valid & TinyGPSFix::COURSE) {
+    ASSERT_EQ(want.course, got.course) << "sentence " << sentence;
+  }
+  if (want.valid & TinyGPSFix::ALTITUDE) {
+    ASSERT_EQ(want.altitude, got.altitude) << "sentence " << sentence;
+  }
+  if (want.valid & TinyGPSFix::SATELLITES) {
+    ASSERT_EQ(want.satellites, got.satellites) << "sentence " << sentence;
+  }
+  if (want.valid & TinyGPSFix::HDOP) {
+    ASSERT_EQ(want.hdop, got.hdop) << "sentence " << sentence;
+  }
+}
+
+void expectSameAsSequential(const std::string &stream, unsigned threads,
+                            size_t chunkSize) {
+  uint32_t failed;
+  std::vector<TinyGPSFix> want = sequential(stream, failed);
+
+  TinyGPSReplay replay(threads, chunkSize);
+  std::vector<TinyGPSFix> got;
+  replay.replay(stream.data(), stream.size(), collect, &got);
+
+  ASSERT_EQ(want.size(), got.size());
+  for (size_t i = 0; i < want.size(); ++i) {
+    ASSERT_EQ(i + 1, got[i].commitTime);
+    expectSameFix(want[i], got[i], i);
+  }
+  EXPECT_EQ(want.size(), replay.passedChecksum());
+  EXPECT_EQ(failed, replay.failedChecksum());
+}
+
+std::string logStream(uint32_t seed, unsigned sentences, double noise) {
+  bench::NMEAGenerator::Options options;
+  options.seed = seed;
+  options.rateHz = 5;
+  options.sentences = sentences;
+  options.talkers = {"GN", "GP", "GL"};
+  options.lineEnding = bench::NMEAGenerator::MIXED;
+  options.corruptChecksum = noise;
+  options.truncate = noise;
+  options.overlongField = noise;
+  return bench::NMEAGenerator(options).seconds(120);
+}
+
+const unsigned allSentences = ~0u;
+
+TEST(ReplayTest, CleanLog) {
+  std::string stream = logStream(1, allSentences, 0);
+  expectSameAsSequential(stream, 1, 4 << 20);
+  expectSameAsSequential(stream, 4, 4096);
+}
+
+// Chunks much shorter than a sentence leave most values staged in one chunk
+// and committed in another
+TEST(ReplayTest, TinyChunks) {
+  std::string stream = logStream(2, allSentences, 0);
+  expectSameAsSequential(stream, 3, 1);
+  expectSameAsSequential(stream, 2, 97);
+}
+
+TEST(ReplayTest, NoisyLog) {
+  std::string stream = logStream(3, allSentences, 0.05);
+  expectSameAsSequential(stream, 4, 1);
+  expectSameAsSequential(stream, 4, 1000);
+  expectSameAsSequential(stream, 8, 65536);
+}
+
+// ZDA stages the day, month and year as separate terms, and an empty term
+// leaves its part of the previously staged date in place, so each part must
+// be stitched on its own
+TEST(ReplayTest, DatePartsAcrossChunks) {
+  bench::Random rng(4);
+  std::string stream;
+  char body[96];
+  for (int i = 0; i < 2000; ++i) {
+    unsigned day = 1 + rng.below(28), month = 1 + rng.below(12);
+    unsigned year = 1990 + rng.below(100);
+    if (rng.below(4) == 0) {
+      snprintf(body, sizeof(body),
+               "GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,"
+               "%02u%02u%02u,003.1,W",
+               day, month, year % 100);
+    } else {
+      std::string parts[3] = {std::to_string(day), std::to_string(month),
+                              std::to_string(year)};
+      for (int k = 0; k < 3; ++k)
+        if (rng.below(3) == 0)
+          parts[k].clear();
+      snprintf(body, sizeof(body), "GPZDA,123519.00,%s,%s,%s,,",
+               parts[0].c_str(), parts[1].c_str(), parts[2].c_str());
+    }
+    bench::appendSentence(stream, body);
+  }
+  expectSameAsSequential(stream, 4, 1);
+  expectSameAsSequential(stream, 4, 300);
+}
+
+// Consecutive calls continue the same replay when each buffer ends at a
+// sentence boundary
+TEST(ReplayTest, ConsecutiveBuffers) {
+  std::string stream = logStream(5, allSentences, 0.02);
+  uint32_t failed;
+  std::vector<TinyGPSFix> want = sequential(stream, failed);
+
+  TinyGPSReplay replay(4, 512);
+  std::vector<TinyGPSFix> got;
+  bench::Random rng(5);
+  for (size_t i = 0; i < stream.size();) {
+    size_t next = i + 1 + rng.below(20000);
+    next = next < stream.size() ? stream.find('$', next) : stream.size();
+    if (next == std::string::npos)
+      next = stream.size();
+    replay.replay(stream.data() + i, next - i, collect, &got);
+    i = next;
+  }
+
+  ASSERT_EQ(want.size(), got.size());
+  for (size_t i = 0; i < want.size(); ++i)
+    expectSameFix(want[i], got[i], i);
+  EXPECT_EQ(failed, replay.failedChecksum());
+}
+
+// Sentences that fail their checksum, each followed by sentences that leave
+// terms empty, so that values put back by a failure are committed in later
+// chunks
+TEST(ReplayTest, FailedSentencesStageNothing) {
+  bench::Random rng(6);
+  std::string stream;
+  char body[128];
+  for (int i = 0; i < 3000; ++i) {
+    std::string lat = std::to_string(1000 + rng.below(8000)) + ".5";
+    std::string lng = std::to_string(10000 + rng.below(8000)) + ".25";
+    std::string speed = std::to_string(rng.below(100)) + ".5";
+    const char *ns = rng.below(2) ? "S" : "N";
+    const char *ew = rng.below(2) ? "W" : "E";
+    std::string *terms[] = {&lat, &lng, &speed};
+    for (int k = 0; k < 3; ++k)
+      if (rng.below(3) == 0)
+        terms[k]->clear();
+    if (rng.below(2)) {
+      snprintf(body, sizeof(body), "GPRMC,%06u,A,%s,%s,%s,%s,%s,,%06u,,",
+               rng.below(235959), lat.c_str(), ns, lng.c_str(), ew,
+               speed.c_str(), 10000 + rng.below(280000));
+    } else {
+      snprintf(body, sizeof(body), "GPGGA,%06u,%s,%s,%s,%s,1,%02u,0.9,%s,M,,,,",
+               rng.below(235959), lat.c_str(), ns, lng.c_str(), ew,
+               rng.below(20), speed.c_str());
+    }
+    std::string sentence;
+    bench::appendSentence(sentence, body);
+    if (rng.below(3) == 0)
+      sentence[sentence.size() - 3] ^= 1;
+    stream += sentence;
+  }
+  expectSameAsSequential(stream, 4, 1);
+  expectSameAsSequential(stream, 4, 150);
+  expectSameAsSequential(stream, 2, 5000);
+}
+
+// A NAV-PVT frame at latitude and longitude 1e-7 degrees times lat and lng,
+// with '$' in its reserved bytes
+std::string navPvtFrame(int32_t lat, int32_t lng) {
+  unsigned char payload[92] = {0};
+  payload[20] = 3; // 3D fix
+  payload[21] = 1; // GNSS fix OK
+  payload[22] = '$';
+  for (int i = 0; i < 4; ++i) {
+    payload[24 + i] = (unsigned char)(lng >> (8 * i));
+    payload[28 + i] = (unsigned char)(lat >> (8 * i));
+  }
+  payload[78] = '$';
+  std::string frame("\xB5\x62\x01\x07\x5C\x00", 6);
+  frame.append((const char *)payload, sizeof(payload));
+  uint8_t a = 0, b = 0;
+  for (size_t i = 2; i < frame.size(); ++i) {
+    a += (uint8_t)frame[i];
+    b += a;
+  }
+  frame += (char)a;
+  frame += (char)b;
+  return frame;
+}
+
+// Replay decodes NMEA only: binary frames are read as text, wherever the
+// chunks are cut, and a NAV-PVT frame leaves the fix alone
+TEST(ReplayTest, BinaryFramesAreReadAsText) {
+  std::string text = logStream(7, allSentences, 0);
+  bench::Random rng(7);
+  std::string stream;
+  for (size_t i = 0; i < text.size();) {
+    size_t n = 1 + rng.below(400);
+    stream.append(text, i, n);
+    i += n;
+    stream += navPvtFrame((int32_t)rng.below(900000000),
+                          (int32_t)rng.below(1800000000));
+  }
+
+  std::vector<TinyGPSFix> want;
+  TinyGPSReplay single(1, stream.size());
+  single.replay(stream.data(), stream.size(), collect, &want);
+  std::vector<TinyGPSFix> got;
+  TinyGPSReplay replay(4, 64);
+  replay.replay(stream.data(), stream.size(), collect, &got);
+  ASSERT_EQ(want.size(), got.size());
+  for (size_t i = 0; i < want.size(); ++i)
+    expectSameFix(want[i], got[i], i);
+  EXPECT_EQ(single.failedChecksum(), replay.failedChecksum());
+
+  std::string log;
+  bench::appendSentence(log, "GPGGA,123520,4807.038,N,01131.000,E,1,08,0.9,"
+                             "545.4,M,46.9,M,,");
+  log += navPvtFrame(-338000000, 1512000000);
+  TinyGPSPlus gps;
+  gps.encode(log.data(), log.size());
+  EXPECT_EQ(-33800000000LL, gps.fix().latitude);
+  TinyGPSReplay nmeaOnly(2, 16);
+  nmeaOnly.replay(log.data(), log.size(), NULL, NULL);
+  EXPECT_EQ(1u, nmeaOnly.passedChecksum());
+  EXPECT_EQ(48117300000LL, nmeaOnly.fix().latitude);
+}
+
+} // namespace
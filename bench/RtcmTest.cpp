@@ -0,0 +1,166 @@
+// Tests that TinyGPSPlus steps over RTCM3 frames mixed into the NMEA stream
+// and that both encode paths count and forward the same frames.
+
+#include "NMEAGenerator.h"
+#include "TinyGPS++.h"
+#include "TinyGPSRTCM.h"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+// A message type 1005 frame from a reference station, CRC included
+const unsigned char kFrame1005[] = {
+    0xD3, 0x00, 0x13, 0x3E, 0xD7, 0xD3, 0x02, 0x02, 0x98,
+    0x0E, 0xDE, 0xEF, 0x34, 0xB4, 0xBD, 0x62, 0xAC, 0x09,
+    0x41, 0x98, 0x6F, 0x33, 0x36, 0x0B, 0x98};
+
+// A frame of the given payload, its CRC corrupted when broken
+std::string rtcmFrame(const std::string &payload, bool broken = false) {
+  std::string frame;
+  frame += (char)TinyGPSRTCM::PREAMBLE;
+  frame += (char)(payload.size() >> 8);
+  frame += (char)payload.size();
+  frame += payload;
+  uint32_t crc =
+      TinyGPSRTCM::crc24q(0, (const uint8_t *)frame.data(), frame.size());
+  if (broken)
+    crc ^= 1;
+  frame += (char)(crc >> 16);
+  frame += (char)(crc >> 8);
+  frame += (char)crc;
+  return frame;
+}
+
+// A payload starting with the 12 bit message type, then filler
+std::string typedPayload(uint16_t type, const std::string &rest) {
+  std::string payload;
+  payload += (char)(type >> 4);
+  payload += (char)((type & 0xF) << 4);
+  return payload + rest;
+}
+
+struct Forwarded {
+  std::vector<std::string> frames;
+  std::vector<uint16_t> types;
+
+  static void callback(const uint8_t *frame, size_t length, uint16_t type,
+                       void *context) {
+    Forwarded *f = (Forwarded *)context;
+    f->frames.push_back(std::string((const char *)frame, length));
+    f->types.push_back(type);
+  }
+};
+
+// Feeds stream a character at a time, or in chunks of at most chunk
+// characters when chunk is nonzero
+void feed(TinyGPSPlus &gps, const std::string &stream, size_t chunk) {
+  if (chunk == 0) {
+    for (size_t i = 0; i < stream.size(); ++i)
+      gps.encode(stream[i]);
+    return;
+  }
+  bench::Random rng(3);
+  for (size_t i = 0; i < stream.size();) {
+    size_t n = 1 + rng.below((uint32_t)chunk);
+    if (n > stream.size() - i)
+      n = stream.size() - i;
+    gps.encode(stream.data() + i, n);
+    i += n;
+  }
+}
+
+TEST(RtcmTest, Crc24q) {
+  EXPECT_EQ(0x360B98u,
+            TinyGPSRTCM::crc24q(0, kFrame1005, sizeof(kFrame1005) - 3));
+  // The CRC of a frame including its own CRC is 0
+  EXPECT_EQ(0u, TinyGPSRTCM::crc24q(0, kFrame1005, sizeof(kFrame1005)));
+
+  TinyGPSRTCM rtcm;
+  uint8_t status = TinyGPSRTCM::NOT_RTCM;
+  for (size_t i = 0; i < sizeof(kFrame1005); ++i)
+    status = rtcm.encode(kFrame1005[i]);
+  EXPECT_EQ(TinyGPSRTCM::PASSED, status);
+  EXPECT_EQ(1005, rtcm.lastMessageType());
+}
+
+// Every path counts the same frames per type and forwards them intact
+TEST(RtcmTest, CountsAndForwardsOnBothPaths) {
+  std::string stream, frame1077 = rtcmFrame(typedPayload(1077, "\x01\x02"));
+  std::vector<std::string> want;
+  bench::appendSentence(stream, "GPGGA,123519,4807.038,N,01131.000,E,1,08,"
+                                "0.9,545.4,M,46.9,M,,");
+  for (int i = 0; i < 3; ++i) {
+    want.push_back(std::string((const char *)kFrame1005,
+                               sizeof(kFrame1005)));
+    stream += want.back();
+    want.push_back(frame1077);
+    stream += frame1077;
+  }
+  stream += rtcmFrame(typedPayload(1230, "xyz"), true);
+  // Payloads of one character and of none carry no message type
+  want.push_back(rtcmFrame("\x7F"));
+  stream += want.back();
+  want.push_back(rtcmFrame(""));
+  stream += want.back();
+  bench::appendSentence(stream, "GPRMC,123520,A,4807.038,N,01131.000,E,"
+                                "022.4,084.4,230394,003.1,W");
+
+  const size_t chunks[] = {0, 1, 5, 40, stream.size()};
+  for (size_t c = 0; c < sizeof(chunks) / sizeof(chunks[0]); ++c) {
+    SCOPED_TRACE(chunks[c]);
+    TinyGPSPlus gps;
+    Forwarded forwarded;
+    gps.rtcm.forward(Forwarded::callback, &forwarded);
+    feed(gps, stream, chunks[c]);
+
+    EXPECT_EQ(2u, gps.passedChecksum());
+    EXPECT_EQ(0u, gps.failedChecksum());
+    EXPECT_EQ(8u, gps.rtcm.passedFrames());
+    EXPECT_EQ(1u, gps.rtcm.failedFrames());
+    ASSERT_EQ(3, gps.rtcm.typeCount());
+    EXPECT_EQ(1005, gps.rtcm.messageType(0));
+    EXPECT_EQ(1077, gps.rtcm.messageType(1));
+    EXPECT_EQ(0, gps.rtcm.messageType(2));
+    EXPECT_EQ(3u, gps.rtcm.framesOfType(1005));
+    EXPECT_EQ(3u, gps.rtcm.framesOfType(1077));
+    EXPECT_EQ(2u, gps.rtcm.framesOfType(0));
+    EXPECT_EQ(0u, gps.rtcm.framesOfType(1230));
+    EXPECT_EQ(0, gps.rtcm.lastMessageType());
+    EXPECT_EQ(want, forwarded.frames);
+    std::vector<uint16_t> types = {1005, 1077, 1005, 1077, 1005, 1077, 0, 0};
+    EXPECT_EQ(types, forwarded.types);
+  }
+}
+
+// NMEA delimiters inside a payload are part of the frame, not a sentence
+TEST(RtcmTest, DollarInPayloadKeepsNmeaSync) {
+  std::string inside;
+  bench::appendSentence(inside, "GPRMC,000000,A,0000.000,S,00000.000,W,"
+                                "999.9,359.9,010100,,");
+  std::string stream;
+  bench::appendSentence(stream, "GPRMC,123519,A,4807.038,N,01131.000,E,"
+                                "022.4,084.4,230394,003.1,W");
+  stream += rtcmFrame(typedPayload(1005, "$GP" + inside + "*,\r\n$"));
+  stream += rtcmFrame(typedPayload(1005, inside));
+  bench::appendSentence(stream, "GPGGA,123520,4807.040,N,01131.000,E,1,08,"
+                                "0.9,545.4,M,46.9,M,,");
+
+  const size_t chunks[] = {0, 1, 7, stream.size()};
+  for (size_t c = 0; c < sizeof(chunks) / sizeof(chunks[0]); ++c) {
+    SCOPED_TRACE(chunks[c]);
+    TinyGPSPlus gps;
+    feed(gps, stream, chunks[c]);
+    EXPECT_EQ(2u, gps.passedChecksum());
+    EXPECT_EQ(0u, gps.failedChecksum());
+    EXPECT_EQ(2u, gps.rtcm.passedFrames());
+    EXPECT_NEAR(48.117333, gps.location.lat(), 1e-6);
+    EXPECT_EQ(2240, gps.speed.value());
+    EXPECT_EQ(230394u, gps.date.value());
+    EXPECT_EQ(12352000u, gps.time.value());
+  }
+}
+
+} // namespace
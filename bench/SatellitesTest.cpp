@@ -0,0 +1,206 @@
+// Tests that TinyGPSSatellites commits whole GSV groups only, and tells the
+// satellites used in the solution apart across the PRN numberings receivers
+// use.
+
+#include "NMEAGenerator.h"
+#include "TinyGPS++.h"
+#include "TinyGPSSatellites.h"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace {
+
+void feed(TinyGPSPlus &gps, const char *body) {
+  std::string sentence;
+  bench::appendSentence(sentence, body);
+  gps.encode(sentence.data(), sentence.size());
+}
+
+struct Satellite {
+  uint16_t prn;
+  int elevation;
+  uint16_t azimuth;
+  int snr; // -1 for an empty SNR field, satellite not tracked
+};
+
+// The GSV messages of one group, four satellites to a message
+std::vector<std::string> gsvGroup(const char *talker,
+                                  const std::vector<Satellite> &sats) {
+  size_t messages = (sats.size() + 3) / 4;
+  std::vector<std::string> group;
+  for (size_t m = 0; m < messages; ++m) {
+    std::string body = std::string(talker) + "GSV," +
+                       std::to_string(messages) + "," +
+                       std::to_string(m + 1) + "," +
+                       std::to_string(sats.size());
+    for (size_t i = m * 4; i < sats.size() && i < m * 4 + 4; ++i) {
+      body += "," + std::to_string(sats[i].prn) + "," +
+              std::to_string(sats[i].elevation) + "," +
+              std::to_string(sats[i].azimuth) + ",";
+      if (sats[i].snr >= 0)
+        body += std::to_string(sats[i].snr);
+    }
+    group.push_back(body);
+  }
+  return group;
+}
+
+std::vector<Satellite> numbered(size_t count, uint16_t firstPrn) {
+  std::vector<Satellite> sats;
+  for (size_t i = 0; i < count; ++i)
+    sats.push_back({(uint16_t)(firstPrn + i), (int)(10 + i),
+                    (uint16_t)(30 * i), i % 3 == 2 ? -1 : (int)(20 + i)});
+  return sats;
+}
+
+void expectTable(const TinyGPSSatellites &sats,
+                 const std::vector<Satellite> &want, uint8_t first,
+                 uint8_t constellation) {
+  for (size_t i = 0; i < want.size(); ++i) {
+    uint8_t k = (uint8_t)(first + i);
+    EXPECT_EQ(want[i].prn, sats.prn(k)) << i;
+    EXPECT_EQ(want[i].elevation, sats.elevation(k)) << i;
+    EXPECT_EQ(want[i].azimuth, sats.azimuth(k)) << i;
+    EXPECT_EQ(want[i].snr < 0 ? 0 : want[i].snr, sats.snr(k)) << i;
+    EXPECT_EQ(constellation, sats.constellation(k)) << i;
+  }
+}
+
+// The table changes only when the last message of a group arrives
+TEST(SatellitesTest, MultiMessageGroupCommits) {
+  TinyGPSPlus gps;
+  TinyGPSSatellites sats(gps);
+  std::vector<Satellite> want = numbered(10, 1);
+  want[9].elevation = -3;
+  std::vector<std::string> group = gsvGroup("GP", want);
+  ASSERT_EQ(3u, group.size());
+
+  feed(gps, group[0].c_str());
+  feed(gps, group[1].c_str());
+  EXPECT_FALSE(sats.isValid());
+  EXPECT_FALSE(sats.isUpdated());
+  EXPECT_EQ(0, sats.count());
+
+  feed(gps, group[2].c_str());
+  EXPECT_TRUE(sats.isValid());
+  EXPECT_TRUE(sats.isUpdated());
+  ASSERT_EQ(10, sats.count());
+  EXPECT_FALSE(sats.isUpdated());
+  expectTable(sats, want, 0, TinyGPSSatellites::GPS);
+  EXPECT_EQ(3u, gps.passedChecksum());
+}
+
+// A group missing a message, or with one out of order or corrupted, leaves
+// the table as the last whole group left it
+TEST(SatellitesTest, BrokenGroupIsDropped) {
+  TinyGPSPlus gps;
+  TinyGPSSatellites sats(gps);
+  std::vector<Satellite> first = numbered(10, 1);
+  for (const std::string &m : gsvGroup("GP", first))
+    feed(gps, m.c_str());
+  ASSERT_EQ(10, sats.count());
+
+  std::vector<std::string> next = gsvGroup("GP", numbered(9, 11));
+  // Message 2 dropped
+  feed(gps, next[0].c_str());
+  feed(gps, next[2].c_str());
+  // Messages 2 and 3 swapped
+  feed(gps, next[0].c_str());
+  feed(gps, next[2].c_str());
+  feed(gps, next[1].c_str());
+  // Message 2 fails its checksum
+  std::string corrupt;
+  bench::appendSentence(corrupt, next[1]);
+  corrupt[corrupt.size() - 3] ^= 1;
+  feed(gps, next[0].c_str());
+  gps.encode(corrupt.data(), corrupt.size());
+  feed(gps, next[2].c_str());
+  // Message 2 from another talker
+  feed(gps, next[0].c_str());
+  feed(gps, gsvGroup("GL", numbered(9, 65))[1].c_str());
+  feed(gps, next[2].c_str());
+
+  EXPECT_EQ(1u, gps.failedChecksum());
+  ASSERT_EQ(10, sats.count());
+  expectTable(sats, first, 0, TinyGPSSatellites::GPS);
+
+  // The next whole group replaces it
+  std::vector<Satellite> last = numbered(9, 11);
+  for (const std::string &m : gsvGroup("GP", last))
+    feed(gps, m.c_str());
+  ASSERT_EQ(9, sats.count());
+  expectTable(sats, last, 0, TinyGPSSatellites::GPS);
+}
+
+// Each talker's group replaces only its own satellites, so the table holds
+// every satellite in view across systems
+TEST(SatellitesTest, TotalInView) {
+  TinyGPSPlus gps;
+  TinyGPSSatellites sats(gps);
+  std::vector<Satellite> gp = numbered(10, 1), gl = numbered(7, 65),
+                         ga = numbered(5, 1);
+  for (const std::string &m : gsvGroup("GP", gp))
+    feed(gps, m.c_str());
+  for (const std::string &m : gsvGroup("GL", gl))
+    feed(gps, m.c_str());
+  for (const std::string &m : gsvGroup("GA", ga))
+    feed(gps, m.c_str());
+  ASSERT_EQ(22, sats.count());
+  expectTable(sats, gp, 0, TinyGPSSatellites::GPS);
+  expectTable(sats, gl, 10, TinyGPSSatellites::GLONASS);
+  expectTable(sats, ga, 17, TinyGPSSatellites::GALILEO);
+
+  // Fewer GPS satellites in view: the others keep theirs
+  gp = numbered(3, 20);
+  for (const std::string &m : gsvGroup("GP", gp))
+    feed(gps, m.c_str());
+  ASSERT_EQ(15, sats.count());
+  expectTable(sats, gl, 0, TinyGPSSatellites::GLONASS);
+  expectTable(sats, ga, 7, TinyGPSSatellites::GALILEO);
+  expectTable(sats, gp, 12, TinyGPSSatellites::GPS);
+
+  // More than the table holds: it fills up and the rest are left out
+  std::vector<Satellite> many = numbered(_GPS_MAX_SATELLITES + 4, 1);
+  for (const std::string &m : gsvGroup("GN", many))
+    feed(gps, m.c_str());
+  EXPECT_EQ(_GPS_MAX_SATELLITES, sats.count());
+}
+
+// SBAS PRNs 120-127 are NMEA 33-40, not the satellites NMEA numbers 56-63
+TEST(SatellitesTest, SbasPrnsDoNotCollide) {
+  TinyGPSPlus gps;
+  TinyGPSSatellites sats(gps);
+  feed(gps, "GPGSA,A,3,05,123,127,,,,,,,,,,1.5,0.9,1.2");
+
+  EXPECT_EQ(3, sats.usedCount());
+  EXPECT_TRUE(sats.isUsed(TinyGPSSatellites::GPS, 5));
+  EXPECT_TRUE(sats.isUsed(TinyGPSSatellites::SBAS, 123));
+  EXPECT_TRUE(sats.isUsed(TinyGPSSatellites::SBAS, 127));
+  for (uint16_t prn = 56; prn <= 63; ++prn)
+    EXPECT_FALSE(sats.isUsed(TinyGPSSatellites::SBAS, prn)) << prn;
+}
+
+// A satellite is the same whichever of its numbers is asked about
+TEST(SatellitesTest, NumberingsAgree) {
+  TinyGPSPlus gps;
+  TinyGPSSatellites sats(gps);
+  feed(gps, "GNGSA,A,3,36,,,,,,,,,,,,1.5,0.9,1.2,1");
+  feed(gps, "GNGSA,A,3,70,,,,,,,,,,,,1.5,0.9,1.2,2");
+  feed(gps, "GNGSA,A,3,05,,,,,,,,,,,,1.5,0.9,1.2,3");
+  feed(gps, "GNGSA,A,3,407,,,,,,,,,,,,1.5,0.9,1.2,4");
+
+  EXPECT_EQ(4, sats.usedCount());
+  EXPECT_TRUE(sats.isUsed(TinyGPSSatellites::SBAS, 36));
+  EXPECT_TRUE(sats.isUsed(TinyGPSSatellites::SBAS, 123));
+  EXPECT_TRUE(sats.isUsed(TinyGPSSatellites::GLONASS, 70));
+  EXPECT_TRUE(sats.isUsed(TinyGPSSatellites::GLONASS, 6));
+  EXPECT_TRUE(sats.isUsed(TinyGPSSatellites::GALILEO, 5));
+  EXPECT_TRUE(sats.isUsed(TinyGPSSatellites::GALILEO, 305));
+  EXPECT_TRUE(sats.isUsed(TinyGPSSatellites::BEIDOU, 7));
+  EXPECT_TRUE(sats.isUsed(TinyGPSSatellites::BEIDOU, 407));
+  EXPECT_FALSE(sats.isUsed(TinyGPSSatellites::GPS, 5));
+}
+
+} // namespace
@@ -0,0 +1,102 @@
+// Tests that TinyGPSSentence splits a line into the terms and checksum
+// encode() sees, and that TinyGPSField parses numbers as encode() does.
+
+#include "NMEAGenerator.h"
+#include "TinyGPS++.h"
+#include "TinyGPSSentence.h"
+
+#include <gtest/gtest.h>
+#include <string>
+
+namespace {
+
+std::string sentence(const char *body) {
+  std::string s;
+  bench::appendSentence(s, body);
+  return s;
+}
+
+TEST(SentenceTest, SplitsTerms) {
+  std::string s = sentence("GPRMC,123519,A,4807.038,N,,E,022.4");
+  TinyGPSSentence parsed;
+  ASSERT_TRUE(parsed.parse(s.data(), s.data() + s.size()));
+
+  EXPECT_TRUE(parsed.isValid());
+  EXPECT_FALSE(parsed.isTruncated());
+  ASSERT_EQ(8u, parsed.size());
+  EXPECT_TRUE(parsed.term(0).equals("GPRMC"));
+  EXPECT_TRUE(parsed.term(1).equals("123519"));
+  EXPECT_TRUE(parsed.term(4).equals("N"));
+  EXPECT_TRUE(parsed.term(5).empty());
+  EXPECT_TRUE(parsed.term(7).equals("022.4"));
+  EXPECT_TRUE(parsed.term(8).empty());
+  EXPECT_TRUE(parsed.talker().equals("GP"));
+  EXPECT_TRUE(parsed.formatter().equals("RMC"));
+  EXPECT_EQ(2u, parsed.checksum().size());
+  // The views point into the line, not into copies
+  EXPECT_EQ(s.data() + 1, parsed.term(0).data());
+}
+
+TEST(SentenceTest, ProprietaryTalker) {
+  std::string s = sentence("PUBX,00,081350.00");
+  TinyGPSSentence parsed;
+  ASSERT_TRUE(parsed.parse(s.c_str()));
+  EXPECT_TRUE(parsed.talker().equals("P"));
+  EXPECT_TRUE(parsed.formatter().equals("UBX"));
+  EXPECT_EQ(3u, parsed.size());
+}
+
+TEST(SentenceTest, Checksum) {
+  // The example of the NMEA 0183 standard
+  TinyGPSSentence parsed;
+  EXPECT_TRUE(parsed.parse("$GPGLL,5057.970,N,00146.110,E,142451,A*27"));
+  EXPECT_TRUE(parsed.checksum().equals("27"));
+  EXPECT_TRUE(parsed.parse("GPGLL,5057.970,N,00146.110,E,142451,A*27\r\n"));
+  EXPECT_TRUE(parsed.parse("$GPGLL,5057.970,N,00146.110,E,142451,A*27$GP"));
+
+  EXPECT_FALSE(parsed.parse("$GPGLL,5057.970,N,00146.110,E,142451,A*28"));
+  EXPECT_FALSE(parsed.isValid());
+  EXPECT_EQ(7u, parsed.size());
+  EXPECT_FALSE(parsed.parse("$GPGLL,5057.970,N,00146.110,E,142451,A*2"));
+  EXPECT_FALSE(parsed.parse("$GPGLL,5057.970,N,00146.110,E,142451,A"));
+  EXPECT_TRUE(parsed.checksum().empty());
+  EXPECT_FALSE(parsed.parse("$GPGLL,5057.970,N,00146.110,E,142451,B*27"));
+}
+
+// Terms past _GPS_MAX_SENTENCE_TERMS are dropped but still checksummed
+TEST(SentenceTest, Truncated) {
+  std::string body = "GPXXX";
+  for (int i = 0; i < _GPS_MAX_SENTENCE_TERMS + 5; ++i)
+    body += "," + std::to_string(i);
+  std::string s = sentence(body.c_str());
+  TinyGPSSentence parsed;
+  EXPECT_TRUE(parsed.parse(s.data(), s.data() + s.size()));
+  EXPECT_TRUE(parsed.isTruncated());
+  EXPECT_EQ((size_t)_GPS_MAX_SENTENCE_TERMS, parsed.size());
+  EXPECT_TRUE(parsed.term(_GPS_MAX_SENTENCE_TERMS - 1)
+                  .equals(std::to_string(_GPS_MAX_SENTENCE_TERMS - 2).c_str()));
+}
+
+// A number longer than encode() keeps of a term is cut where encode() cuts
+// it, so both read the same value
+TEST(SentenceTest, LongNumbersParseAsEncodeDoes) {
+  const char *altitudes[] = {"545.4", "00000000000545.4", "000000000000545.4",
+                             "0000000000000545.4", "123456789012345678"};
+  for (size_t i = 0; i < sizeof(altitudes) / sizeof(altitudes[0]); ++i) {
+    std::string body = "GPGGA,123520,4807.040,N,01131.000,E,1,08,0.9,";
+    body += altitudes[i];
+    body += ",M,46.9,M,,";
+    std::string s = sentence(body.c_str());
+
+    TinyGPSPlus gps;
+    for (size_t k = 0; k < s.size(); ++k)
+      gps.encode(s[k]);
+    TinyGPSSentence parsed;
+    ASSERT_TRUE(parsed.parse(s.data(), s.data() + s.size()));
+    ASSERT_TRUE(gps.altitude.isValid());
+    EXPECT_EQ(gps.altitude.value(), parsed.term(9).toDecimal())
+        << altitudes[i];
+  }
+}
+
+} // namespace
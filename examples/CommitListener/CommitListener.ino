@@ -0,0 +1,76 @@
+#include <TinyGPS++.h>
+#include <SoftwareSerial.h>
+/*
+   This sample sketch demonstrates how to react to new fixes with commit
+   listeners instead of polling isUpdated() after every character.
+
+   The listener below is called once for each sentence that passes its
+   checksum and commits a location. By then every field of that sentence is
+   committed, so the location, time and satellite count printed all belong
+   to the same fix.
+
+   It requires the use of SoftwareSerial, and assumes that you have a
+   4800-baud serial GPS device hooked up on pins 4(rx) and 3(tx).
+*/
+static const int RXPin = 4, TXPin = 3;
+static const uint32_t GPSBaud = 4800;
+
+// The TinyGPS++ object
+TinyGPSPlus gps;
+
+// The serial connection to the GPS device
+SoftwareSerial ss(RXPin, TXPin);
+
+// Called by gps.encode() when a sentence commits a location
+static void onLocation(TinyGPSPlus &gps, const TinyGPSCommit &commit, void *)
+{
+  Serial.print(F("Location: "));
+  Serial.print(gps.location.lat(), 6);
+  Serial.print(F(","));
+  Serial.print(gps.location.lng(), 6);
+
+  if (commit.fields & TinyGPSPlus::COMMIT_TIME)
+  {
+    Serial.print(F("  Time: "));
+    Serial.print(gps.time.hour());
+    Serial.print(F(":"));
+    Serial.print(gps.time.minute());
+    Serial.print(F(":"));
+    Serial.print(gps.time.second());
+  }
+
+  if (commit.fields & TinyGPSPlus::COMMIT_SATELLITES)
+  {
+    Serial.print(F("  Sats: "));
+    Serial.print(gps.satellites.value());
+  }
+
+  Serial.println();
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  ss.begin(GPSBaud);
+
+  Serial.println(F("CommitListener.ino"));
+  Serial.println(F("Reacting to new fixes with a TinyGPS++ commit listener"));
+  Serial.print(F("Testing TinyGPS++ library v. ")); Serial.println(TinyGPSPlus::libraryVersion());
+  Serial.println(F("by Mikal Hart"));
+  Serial.println();
+
+  gps.addListener(onLocation, NULL, TinyGPSPlus::COMMIT_LOCATION);
+}
+
+void loop()
+{
+  // Listeners run from inside encode()
+  while (ss.available() > 0)
+    gps.encode(ss.read());
+
+  if (millis() > 5000 && gps.charsProcessed() < 10)
+  {
+    Serial.println(F("No GPS detected: check wiring."));
+    while(true);
+  }
+}
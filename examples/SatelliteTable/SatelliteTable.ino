@@ -0,0 +1,75 @@
+#include <TinyGPS++.h>
+#include <TinyGPSSatellites.h>
+#include <SoftwareSerial.h>
+/*
+   This sample code demonstrates how to use TinyGPSSatellites to monitor all
+   the visible satellites of every constellation.
+
+   TinyGPSSatellites decodes the $GxGSV sentences into a table of satellite
+   numbers, elevation, azimuth, signal-to-noise ratio and constellation. The
+   table is only updated once all the messages of a GSV group have arrived.
+   Compare with SatelliteTracker.ino, which does the same for GPS alone with
+   19 TinyGPSCustom objects.
+
+   It requires the use of SoftwareSerial, and assumes that you have a
+   4800-baud serial GPS device hooked up on pins 4(RX) and 3(TX).
+*/
+static const int RXPin = 4, TXPin = 3;
+static const uint32_t GPSBaud = 4800;
+
+// The TinyGPS++ object
+TinyGPSPlus gps;
+
+// The table of satellites in view, fed by gps
+TinyGPSSatellites sats(gps);
+
+// The serial connection to the GPS device
+SoftwareSerial ss(RXPin, TXPin);
+
+static const char *constellationName(uint8_t constellation)
+{
+  switch (constellation)
+  {
+  case TinyGPSSatellites::GPS:     return "GPS";
+  case TinyGPSSatellites::SBAS:    return "SBAS";
+  case TinyGPSSatellites::GLONASS: return "GLONASS";
+  case TinyGPSSatellites::GALILEO: return "Galileo";
+  case TinyGPSSatellites::BEIDOU:  return "BeiDou";
+  case TinyGPSSatellites::QZSS:    return "QZSS";
+  default:                         return "?";
+  }
+}
+
+void setup()
+{
+  Serial.begin(115200);
+  ss.begin(GPSBaud);
+
+  Serial.println(F("SatelliteTable.ino"));
+  Serial.println(F("Monitoring satellite location and signal strength using TinyGPSSatellites"));
+  Serial.print(F("Testing TinyGPS++ library v. ")); Serial.println(TinyGPSPlus::libraryVersion());
+  Serial.println(F("by Mikal Hart"));
+  Serial.println();
+}
+
+void loop()
+{
+  // Dispatch incoming characters
+  while (ss.available() > 0)
+    gps.encode(ss.read());
+
+  if (sats.isUpdated())
+  {
+    uint8_t count = sats.count();
+    Serial.print(F("Sats in view=")); Serial.println(count);
+    for (uint8_t i = 0; i < count; ++i)
+    {
+      Serial.print(F("  "));
+      Serial.print(constellationName(sats.constellation(i)));
+      Serial.print(F(" PRN="));       Serial.print(sats.prn(i));
+      Serial.print(F(" Elevation=")); Serial.print(sats.elevation(i));
+      Serial.print(F(" Azimuth="));   Serial.print(sats.azimuth(i));
+      Serial.print(F(" SNR="));       Serial.println(sats.snr(i));
+    }
+  }
+}
@@ -22,29 +22,85 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 */
 
 #include "TinyGPS++.h"
+#include "TinyGPSNumeric.h"
+#include "TinyGPSSatellites.h"
+#include "TinyGPSScanner.h"
 
 /// \file
 /// \brief TinyGPS++ implementation file
-#include <ctype.h>
-#include <stdlib.h>
+#include <math.h>
 #include <string.h>
+#ifdef _GPS_HOST_BUILD
+#include <chrono>
+#include <type_traits>
+#endif
+#ifdef __AVR__
+#include <avr/pgmspace.h>
+#endif
+
+#ifdef __AVR__
+#define _GPS_PROGMEM PROGMEM ///< keeps a constant table in flash on AVR
+#define _GPS_READ_BYTE(p) pgm_read_byte(p) ///< reads a _GPS_PROGMEM byte
+#define _GPS_READ_WORD(p) pgm_read_word(p) ///< reads a _GPS_PROGMEM word
+#else
+#define _GPS_PROGMEM
+#define _GPS_READ_BYTE(p) (*(p))
+#define _GPS_READ_WORD(p) (*(p))
+#endif
+
+/// Degrees to radians, as Arduino's DEG_TO_RAD
+#define _GPS_DEG_TO_RAD 0.017453292519943295769236907684886
+/// Radians to degrees, as Arduino's RAD_TO_DEG
+#define _GPS_RAD_TO_DEG 57.295779513082320876798154814105
+/// Full circle in radians, as Arduino's TWO_PI
+#define _GPS_TWO_PI 6.283185307179586476925286766559
+
+/// Pack two characters into an integer so talker IDs can be switched on
+#define _GPS_PACK2(a, b) (((unsigned)(uint8_t)(a) << 8) | (uint8_t)(b))
+
+/// Pack three characters into an integer so sentence formatters can be
+/// switched on
+#define _GPS_PACK3(a, b, c)                                                    \
+  (((uint32_t)(uint8_t)(a) << 16) | ((uint32_t)(uint8_t)(b) << 8) |            \
+   (uint8_t)(c))
+
+TinyGPSClockSource TinyGPSClock::source = TinyGPSClock::defaultSource;
+#ifdef _GPS_HOST_BUILD
+thread_local bool TinyGPSClock::held = false;
+thread_local uint32_t TinyGPSClock::heldTime = 0;
+#else
+bool TinyGPSClock::held = false;
+uint32_t TinyGPSClock::heldTime = 0;
+#endif
+
+uint32_t TinyGPSClock::defaultSource() {
+#ifdef _GPS_HOST_BUILD
+  return (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#else
+  return millis();
+#endif
+}
+
+// The options this library was built with, see TinyGPSConfig.h
+extern const char _GPS_CONFIG_CHECK = 0;
 
-#define _GPRMCterm                                                             \
-  "GPRMC" ///< Time, date, position, course, and speed data. Recommended minimum
-          ///< specific GPS/Transit data
-#define _GPGGAterm                                                             \
-  "GPGGA" ///< Global positioning system fix data (time, position, fix type
-          ///< data)
-#define _GNRMCterm "GNRMC" ///< Time, date, position, course and speed data.
-#define _GNGGAterm                                                             \
-  "GNGGA" ///< Time, position, and fix related data of the receiver.
-
-TinyGPSPlus::TinyGPSPlus()
+TinyGPSPlus::TinyGPSPlus(const char *config)
     : parity(0), isChecksumTerm(false), curSentenceType(GPS_SENTENCE_OTHER),
       curTermNumber(0), curTermOffset(0), sentenceHasFix(false), customElts(0),
-      customCandidates(0), encodedCharCount(0), sentencesWithFixCount(0),
-      failedChecksumCount(0), passedChecksumCount(0) {
+      customCandidates(0), customCursor(0), satelliteTable(0),
+      encodedCharCount(0), sentencesWithFixCount(0), failedChecksumCount(0),
+      passedChecksumCount(0), currentFix() {
   term[0] = '\0';
+  // A volatile read keeps the reference through link-time optimization
+  (void)*(const volatile char *)config;
+#if _GPS_MAX_LISTENERS > 0
+  listenerCount = 0;
+#endif
+#if !_GPS_NO_UBX || !_GPS_NO_RTCM
+  frameFlag = 0;
+#endif
 }
 
 //
@@ -54,61 +110,607 @@ TinyGPSPlus::TinyGPSPlus()
 bool TinyGPSPlus::encode(char c) {
   ++encodedCharCount;
 
+  // Only a character with its high bit set, or one inside a binary frame,
+  // can belong to a frame; NMEA text pays a single test
+#if !_GPS_NO_UBX || !_GPS_NO_RTCM
+  if (((uint8_t)c | frameFlag) & 0x80) {
+    uint8_t result = encodeFrame((uint8_t)c);
+    if (result != FRAME_TEXT)
+      return result == FRAME_VALID;
+  }
+#endif
+
   switch (c) {
   case ',': // term terminators
     parity ^= (uint8_t)c;
     // Fallthrough
   case '\r':
   case '\n':
-  case '*': {
-    bool isValidSentence = false;
-    if (curTermOffset < sizeof(term)) {
-      term[curTermOffset] = 0;
-      isValidSentence = endOfTermHandler();
-    }
-    ++curTermNumber;
-    curTermOffset = 0;
-    isChecksumTerm = c == '*';
-    return isValidSentence;
-  } break;
+  case '*':
+    return endOfTerm(c);
 
   case '$': // sentence begin
-    curTermNumber = curTermOffset = 0;
-    parity = 0;
-    curSentenceType = GPS_SENTENCE_OTHER;
-    isChecksumTerm = false;
-    sentenceHasFix = false;
+    beginSentence();
     return false;
 
   default: // ordinary characters
-    if (curTermOffset < (sizeof(term) - 1))
-      term[curTermOffset++] = c;
-    if (!isChecksumTerm)
-      parity ^= c;
+    addTermChar(c);
     return false;
   }
 
   return false;
 }
 
+uint32_t TinyGPSPlus::encode(const char *buffer, size_t length) {
+  encodedCharCount += length;
+  const char *p = buffer;
+  const char *end = buffer + length;
+  uint32_t validSentences = 0;
+
+  while (p < end) {
+#if !_GPS_NO_UBX || !_GPS_NO_RTCM
+    if (((uint8_t)*p | frameFlag) & 0x80) {
+      p = encodeFrames(p, end, validSentences);
+      continue;
+    }
+#endif
+    p = encodeText(p, end, validSentences);
+  }
+
+  return validSentences;
+}
+
+#if !_GPS_NO_UBX || !_GPS_NO_RTCM
+// Hands c to the binary frame decoders, a frame in progress first. Returns
+// FRAME_TEXT if none of them takes it.
+uint8_t TinyGPSPlus::encodeFrame(uint8_t c) {
+  uint8_t result = FRAME_TEXT;
+#if !_GPS_NO_RTCM
+  if (rtcm.inFrame() && rtcm.encode(c) != TinyGPSRTCM::NOT_RTCM)
+    result = FRAME_BYTE;
+#endif
+#if !_GPS_NO_UBX
+  if (result == FRAME_TEXT && (ubx.inFrame() || c == TinyGPSUBX::SYNC_1)) {
+    uint8_t status = ubx.encode(c);
+    if (status != TinyGPSUBX::NOT_UBX)
+      result = endOfFrame(status) ? FRAME_VALID : FRAME_BYTE;
+  }
+#endif
+#if !_GPS_NO_RTCM
+  if (result == FRAME_TEXT && c == TinyGPSRTCM::PREAMBLE) {
+    rtcm.encode(c);
+    result = FRAME_BYTE;
+  }
+#endif
+  updateFrameFlag();
+  return result;
+}
+
+// The bulk encodeFrame(): hands the frame that starts or continues at p to
+// its decoder in one go and returns where the text resumes. A character that
+// no decoder takes is handled as text, like encode(char) does.
+const char *TinyGPSPlus::encodeFrames(const char *p, const char *end,
+                                      uint32_t &validSentences) {
+  uint8_t c = (uint8_t)*p;
+  const char *next = p;
+  uint8_t status;
+#if !_GPS_NO_RTCM
+  if (rtcm.inFrame())
+    next = rtcm.encode(p, end, status);
+#endif
+#if !_GPS_NO_UBX
+  if (next == p && (ubx.inFrame() || c == TinyGPSUBX::SYNC_1)) {
+    next = ubx.encode(p, end, status);
+    validSentences += endOfFrame(status);
+  }
+#endif
+#if !_GPS_NO_RTCM
+  if (next == p && c == TinyGPSRTCM::PREAMBLE)
+    next = rtcm.encode(p, end, status);
+#endif
+  updateFrameFlag();
+
+  if (next == p) {
+    if (c & 0x80)
+      addTermChar((char)c);
+    else
+      encodeText(p, p + 1, validSentences);
+    ++next;
+  }
+  return next;
+}
+
+void TinyGPSPlus::updateFrameFlag() {
+  bool inFrame = false;
+#if !_GPS_NO_UBX
+  inFrame = ubx.inFrame();
+#endif
+#if !_GPS_NO_RTCM
+  inFrame = inFrame || rtcm.inFrame();
+#endif
+  frameFlag = inFrame ? 0x80 : 0;
+}
+#endif
+
+// The bulk encode() of NMEA text. When binary frames are compiled in, stops
+// at the first character with its high bit set, which may start one, and
+// returns where it stopped.
+const char *TinyGPSPlus::encodeText(const char *p, const char *end,
+                                    uint32_t &validSentences) {
+#if _GPS_NO_UBX && _GPS_NO_RTCM
+  const bool frames = false;
+#else
+  const bool frames = true;
+#endif
+  // While the current sentence is known to end inside buffer, its terms up
+  // to this delimiter can be handed on in place
+  const char *inPlaceEnd = NULL;
+
+  while (p < end) {
+    // Consume a run of ordinary characters in one go
+    const char *run = p;
+    uint8_t runParity = 0;
+    p = frames ? TinyGPSScanner::findDelimiterOrBinary(p, end, runParity)
+               : TinyGPSScanner::findDelimiter(p, end, runParity);
+
+    size_t room = (sizeof(term) - 1) - curTermOffset;
+    size_t count = (size_t)(p - run) < room ? (size_t)(p - run) : room;
+    memcpy(term + curTermOffset, run, count);
+    curTermOffset += count;
+    if (!isChecksumTerm)
+      parity ^= runParity;
+
+    if (p == end || (frames && (*p & 0x80)))
+      break;
+
+    char c = *p++;
+    if (c == '$') {
+      beginSentence();
+      inPlaceEnd = NULL;
+      // A sentence whose checksum term ends before buffer does is settled
+      // there. One that passes is committed at that point, so nothing
+      // staged in place outlives it. One that fails is discarded there, so
+      // its terms are skipped and only its checksum term is fed, which
+      // leaves the state encode(char) does.
+      const char *star, *checksumEnd;
+      uint8_t sum;
+      uint8_t status = checkSentence(p, end, star, checksumEnd, sum, frames);
+      if (status != SENTENCE_INCOMPLETE && checksumEnd < end &&
+          *checksumEnd != '$') {
+        if (status == SENTENCE_PASSED) {
+          inPlaceEnd = checksumEnd;
+        } else {
+          curTermNumber = 1;
+          for (; p != star; ++p)
+            curTermNumber += *p == ',';
+          parity = sum;
+          isChecksumTerm = true;
+          ++p;
+        }
+      }
+    } else {
+      if (c == ',')
+        parity ^= (uint8_t)c;
+      bool valid;
+      if (inPlaceEnd != NULL && p - 1 <= inPlaceEnd) {
+        TinyGPSField field(run, p - 1 - run);
+        valid = endOfTerm(c, &field);
+      } else {
+        valid = endOfTerm(c);
+      }
+      if (valid)
+        ++validSentences;
+    }
+  }
+
+  return p;
+}
+
 bool TinyGPSPlus::isUpdated() const {
   return location.isUpdated() || date.isUpdated() || time.isUpdated() ||
          speed.isUpdated() || course.isUpdated() || altitude.isUpdated() ||
-         satellites.isUpdated() || hdop.isUpdated();
+         satellites.isUpdated() || hdop.isUpdated() || fixMode.isUpdated() ||
+         pdop.isUpdated() || vdop.isUpdated() || timeZone.isUpdated() ||
+         errorStats.isUpdated();
+}
+
+void TinyGPSPlus::consume() {
+  location.consume();
+  date.consume();
+  time.consume();
+  speed.consume();
+  course.consume();
+  altitude.consume();
+  satellites.consume();
+  hdop.consume();
+  fixMode.consume();
+  pdop.consume();
+  vdop.consume();
+  timeZone.consume();
+  errorStats.consume();
+}
+
+#if _GPS_MAX_LISTENERS > 0
+bool TinyGPSPlus::addListener(TinyGPSCommitCallback callback, void *context,
+                              uint16_t fields, uint16_t sentences) {
+  if (listenerCount == _GPS_MAX_LISTENERS)
+    return false;
+  Listener &l = listeners[listenerCount++];
+  l.callback = callback;
+  l.context = context;
+  l.fields = fields;
+  l.sentences = sentences;
+  return true;
+}
+
+void TinyGPSPlus::removeListener(TinyGPSCommitCallback callback,
+                                 void *context) {
+  uint8_t kept = 0;
+  for (uint8_t i = 0; i < listenerCount; ++i)
+    if (listeners[i].callback != callback || listeners[i].context != context)
+      listeners[kept++] = listeners[i];
+  listenerCount = kept;
 }
+#endif
 
 //
 // internal utilities
 //
-int TinyGPSPlus::fromHex(char a) {
-  if (a >= 'A' && a <= 'F')
-    return a - 'A' + 10;
-  else if (a >= 'a' && a <= 'f')
-    return a - 'a' + 10;
-  else
-    return a - '0';
+#if _GPS_MAX_LISTENERS > 0
+// Calls the listeners interested in a sentence that has just committed
+void TinyGPSPlus::notify(uint8_t sentence, uint16_t fields, uint32_t now) {
+  TinyGPSCommit commit;
+  commit.sentence = sentence;
+  commit.fields = fields;
+  commit.time = now;
+  uint16_t sentenceBit = (uint16_t)(1u << sentence);
+  for (uint8_t i = 0; i < listenerCount; ++i) {
+    const Listener &l = listeners[i];
+    if ((l.fields & fields) || (l.sentences & sentenceBit))
+      l.callback(*this, commit, l.context);
+  }
+}
+#endif
+
+#ifdef _GPS_HOST_BUILD
+static_assert(std::is_trivially_copyable<TinyGPSFix>::value,
+              "TinyGPSFix must be copyable as bytes");
+#endif
+
+// Converts RawDegrees to signed billionths of a degree
+static int64_t toBillionths(const RawDegrees &deg) {
+  int64_t value = deg.deg * 1000000000LL + deg.billionths;
+  return deg.negative ? -value : value;
+}
+
+// Copies the TinyGPSFix fields a sentence has just committed into
+// currentFix
+void TinyGPSPlus::updateFix(uint8_t fields, uint32_t now) {
+  TinyGPSFix &fix = currentFix;
+  if (fields & TinyGPSFix::LOCATION) {
+    fix.latitude = toBillionths(location.rawLatData);
+    fix.longitude = toBillionths(location.rawLngData);
+  }
+  if (fields & TinyGPSFix::DATE)
+    fix.date = date.date;
+  if (fields & TinyGPSFix::TIME)
+    fix.time = time.time;
+  if (fields & TinyGPSFix::SPEED)
+    fix.speed = speed.val;
+  if (fields & TinyGPSFix::COURSE)
+    fix.course = course.val;
+  if (fields & TinyGPSFix::ALTITUDE)
+    fix.altitude = altitude.val;
+  if (fields & TinyGPSFix::SATELLITES)
+    fix.satellites = satellites.val > 65535 ? 65535 : (uint16_t)satellites.val;
+  if (fields & TinyGPSFix::HDOP)
+    fix.hdop = hdop.val;
+  fix.valid |= fields;
+  fix.updated = fields;
+  fix.commitTime = now;
+}
+
+#if !_GPS_NO_UBX
+// Accounts for a UBX decoder status like a sentence checksum, committing a
+// NAV-PVT solution that passed
+// Returns true if a frame has just passed its checksum
+bool TinyGPSPlus::endOfFrame(uint8_t status) {
+  if (status == TinyGPSUBX::PASSED) {
+    ++passedChecksumCount;
+    if (ubx.isNavPvt()) {
+      uint32_t now = TinyGPSClock::now();
+      uint16_t fields = commitNavPvt(now);
+      updateFix((uint8_t)fields, now);
+#if _GPS_MAX_LISTENERS > 0
+      if (listenerCount != 0)
+        notify(GPS_FRAME_UBX, fields, now);
+#endif
+    }
+    return true;
+  }
+  if (status == TinyGPSUBX::FAILED)
+    ++failedChecksumCount;
+  return false;
+}
+
+// Converts 1e-7 degrees to RawDegrees
+static void toRawDegrees(int32_t value, RawDegrees &deg) {
+  uint32_t magnitude = value < 0 ? 0u - (uint32_t)value : (uint32_t)value;
+  deg.deg = (uint16_t)(magnitude / 10000000);
+  deg.billionths = magnitude % 10000000 * 100;
+  deg.negative = value < 0;
+}
+
+// Rounds value / divisor to the nearest integer, halves away from zero
+static int32_t divideRounded(int64_t value, int32_t divisor) {
+  return (int32_t)((value < 0 ? value - divisor / 2 : value + divisor / 2) /
+                   divisor);
+}
+
+// Commits a NAV-PVT solution in the units of the NMEA fields. Date and time
+// are committed when the receiver flags them valid, the position and motion
+// with a GNSS fix, the satellite count, fix mode and PDOP always.
+// Returns the COMMIT_* bits of the fields committed
+uint16_t TinyGPSPlus::commitNavPvt(uint32_t now) {
+  const TinyGPSUBX::NavPvt &pvt = ubx.navPvt();
+  bool hasFix = (pvt.flags & TinyGPSUBX::GNSS_FIX_OK) && pvt.fixType >= 2 &&
+                pvt.fixType <= 4;
+  uint16_t fields = COMMIT_SATELLITES | COMMIT_FIX_MODE | COMMIT_PDOP;
+  if (hasFix)
+    ++sentencesWithFixCount;
+
+  if (pvt.validity & TinyGPSUBX::VALID_DATE) {
+    date.newDate = pvt.day * 10000UL + pvt.month * 100UL + pvt.year % 100;
+    date.newFullYear = pvt.year;
+    date.commit(now);
+    fields |= COMMIT_DATE;
+  }
+  if (pvt.validity & TinyGPSUBX::VALID_TIME) {
+    // A negative nano means the second has not quite begun; the hundredths
+    // are then taken as 0 rather than borrowing back through the date
+    time.newTime = pvt.hour * 1000000UL + pvt.minute * 10000UL +
+                   pvt.second * 100UL +
+                   (pvt.nano > 0 ? (uint32_t)pvt.nano / 10000000 : 0);
+    time.commit(now);
+    fields |= COMMIT_TIME;
+  }
+
+  if (hasFix) {
+    toRawDegrees(pvt.latitude, location.rawNewLatData);
+    toRawDegrees(pvt.longitude, location.rawNewLngData);
+    location.commit(now);
+    // mm/s to hundredths of a knot: 1 knot is 1852 m per 3600 s
+    speed.newval = divideRounded((int64_t)pvt.groundSpeed * 360, 1852);
+    speed.commit(now);
+    course.newval = divideRounded(pvt.heading, 1000);
+    course.commit(now);
+    altitude.newval = divideRounded(pvt.heightMSL, 10);
+    altitude.commit(now);
+    fields |= COMMIT_LOCATION | COMMIT_SPEED | COMMIT_COURSE | COMMIT_ALTITUDE;
+  }
+
+  satellites.newval = pvt.satellites;
+  satellites.commit(now);
+  // As GSA: 1 no fix, 2 2D, 3 3D
+  fixMode.newval = 1;
+  if (pvt.fixType == 2)
+    fixMode.newval = 2;
+  else if (pvt.fixType == 3 || pvt.fixType == 4)
+    fixMode.newval = 3;
+  fixMode.commit(now);
+  pdop.newval = pvt.pdop;
+  pdop.commit(now);
+  return fields;
+}
+#endif
+
+void TinyGPSPlus::beginSentence() {
+  curTermNumber = curTermOffset = 0;
+  parity = 0;
+  curSentenceType = GPS_SENTENCE_OTHER;
+  isChecksumTerm = false;
+  sentenceHasFix = false;
+}
+
+// Drops everything a sentence that failed its checksum has staged: the
+// staged values go back to the committed ones, so a later sentence that
+// leaves a term empty cannot commit the failed sentence's value. What
+// follows until the next '$' belongs to no known sentence. The bulk
+// encode() calls this for failed sentences it skips without parsing.
+void TinyGPSPlus::discardSentence() {
+  location.rawNewLatData = location.rawLatData;
+  location.rawNewLngData = location.rawLngData;
+  date.newDate = date.date;
+  date.newFullYear = date.fullYear;
+  time.newTime = time.time;
+  speed.newval = speed.val;
+  course.newval = course.val;
+  altitude.newval = altitude.val;
+  satellites.newval = satellites.val;
+  hdop.newval = hdop.val;
+  fixMode.newval = fixMode.val;
+  pdop.newval = pdop.val;
+  vdop.newval = vdop.val;
+  int16_t zone = timeZone.minutes;
+  timeZone.newNegative = zone < 0;
+  if (zone < 0)
+    zone = -zone;
+  timeZone.newHours = (uint8_t)(zone / 60);
+  timeZone.newMinutes = (uint8_t)(zone % 60);
+  for (uint8_t i = 0; i < TinyGPSErrorStats::FIELDS; ++i)
+    errorStats.newval[i] = errorStats.val[i];
+  for (TinyGPSCustom *p = customElts; p != NULL; p = p->next)
+    p->staged = TinyGPSCustom::STAGED_COMMITTED;
+
+  // A failed sentence ends a run of GSA sentences
+  if (satelliteTable != NULL)
+    satelliteTable->beginActive(term, false);
+  curSentenceType = GPS_SENTENCE_OTHER;
+  customCandidates = customCursor = NULL;
+  sentenceHasFix = false;
+}
+
+// Finishes the current term at delimiter c and starts the next one. inPlace,
+// if given, is the whole term in the caller's buffer.
+// Returns true if new sentence has just passed checksum test and is validated
+bool TinyGPSPlus::endOfTerm(char c, const TinyGPSField *inPlace) {
+  bool isValidSentence = false;
+  if (curTermOffset < sizeof(term)) {
+    term[curTermOffset] = 0;
+    isValidSentence = endOfTermHandler(inPlace);
+  }
+  ++curTermNumber;
+  curTermOffset = 0;
+  isChecksumTerm = c == '*';
+  return isValidSentence;
+}
+
+#ifdef __AVR__
+// Hex digit value, 0xFF for anything that is not a hex digit. Computed on
+// AVR, where a table would take 256 bytes of SRAM.
+static inline uint8_t hexDigit(char c) {
+  uint8_t d = (uint8_t)c - '0';
+  if (d <= 9)
+    return d;
+  d = ((uint8_t)c | 0x20) - 'a';
+  return d <= 5 ? d + 10 : 0xFF;
+}
+#else
+/// Hex digit values, 0xFF for anything that is not a hex digit.
+static const uint8_t hexDigits[256] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0,    1,    2,    3,    4,    5,    6,    7,    8,    9,    0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 10,   11,   12,   13,   14,   15,   0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 10,   11,   12,   13,   14,   15,   0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF};
+
+static inline uint8_t hexDigit(char c) { return hexDigits[(uint8_t)c]; }
+#endif
+
+// Compares the two checksum digits against the computed parity; non-hex
+// digits never match.
+bool TinyGPSPlus::checksumMatches(char hi, char lo, uint8_t parity) {
+  unsigned h = hexDigit(hi);
+  unsigned l = hexDigit(lo);
+  return (((h << 4) | l) ^ parity) == 0;
+}
+
+// Checks the sentence that starts at begin (just after the '$').
+// Returns SENTENCE_INCOMPLETE if no '*' is found before the buffer ends or
+// another delimiter breaks the sentence, or with stopAtBinary, a character
+// with its high bit set does. Otherwise star points at the '*', checksumEnd
+// at the end of the checksum term: the next delimiter, or end, and sum holds
+// the XOR of the characters before the '*'.
+uint8_t TinyGPSPlus::checkSentence(const char *begin, const char *end,
+                                   const char *&star, const char *&checksumEnd,
+                                   uint8_t &sum, bool stopAtBinary) {
+  sum = 0;
+  const char *p =
+      stopAtBinary ? TinyGPSScanner::findSentenceEndOrBinary(begin, end, sum)
+                   : TinyGPSScanner::findSentenceEnd(begin, end, sum);
+  if (p == end || *p != '*')
+    return SENTENCE_INCOMPLETE;
+
+  uint8_t ignored = 0;
+  const char *q =
+      stopAtBinary ? TinyGPSScanner::findDelimiterOrBinary(p + 1, end, ignored)
+                   : TinyGPSScanner::findDelimiter(p + 1, end, ignored);
+  if (q != end && (*q & 0x80))
+    return SENTENCE_INCOMPLETE;
+  star = p;
+  checksumEnd = q;
+  char hi = q - p > 1 ? p[1] : '\0';
+  char lo = q - p > 2 ? p[2] : '\0';
+  return checksumMatches(hi, lo, sum) ? SENTENCE_PASSED : SENTENCE_FAILED;
+}
+
+bool TinyGPSPlus::verifySentence(const char *begin, const char *end) {
+  if (begin < end && *begin == '$')
+    ++begin;
+  const char *star, *checksumEnd;
+  uint8_t sum;
+  return checkSentence(begin, end, star, checksumEnd, sum) == SENTENCE_PASSED;
+}
+
+// True unless every character of a mode term is 'N' (no fix). GNS sends
+// one character per constellation.
+bool TinyGPSPlus::isFixMode(const TinyGPSField &term) {
+  size_t i = 0;
+  while (i < term.size() && term[i] == 'N')
+    ++i;
+  return i < term.size();
 }
 
+uint8_t TinyGPSPlus::termKind(uint8_t sentenceType, uint8_t termNumber) {
+  if (sentenceType >= GPS_SENTENCE_OTHER || termNumber >= MAPPED_TERMS)
+    return TERM_NONE;
+  return _GPS_READ_BYTE(&termMap[sentenceType][termNumber]);
+}
+
+// Stages decoded terms into the objects of a TinyGPSPlus, to be committed
+// when the sentence passes its checksum
+struct TinyGPSPlus::TermSink {
+  TinyGPSPlus &gps;
+
+  void time(uint32_t value) { gps.time.newTime = value; }
+  void date(uint32_t value) {
+    gps.date.newDate = value;
+    gps.date.newFullYear = (uint16_t)(2000 + value % 100);
+  }
+  void day(uint32_t value) {
+    gps.date.newDate = dateWithDay(gps.date.newDate, value);
+  }
+  void month(uint32_t value) {
+    gps.date.newDate = dateWithMonth(gps.date.newDate, value);
+  }
+  void year(uint32_t value) {
+    gps.date.newFullYear = (uint16_t)value;
+    gps.date.newDate = dateWithYear(gps.date.newDate, gps.date.newFullYear);
+  }
+  void zoneHours(bool negative, uint8_t hours) {
+    gps.timeZone.newNegative = negative;
+    gps.timeZone.newHours = hours;
+  }
+  void zoneMinutes(uint8_t minutes) { gps.timeZone.newMinutes = minutes; }
+  void latitude(const RawDegrees &deg) { gps.location.rawNewLatData = deg; }
+  void south(bool south) { gps.location.setLatitudeNegative(south); }
+  void longitude(const RawDegrees &deg) { gps.location.rawNewLngData = deg; }
+  void west(bool west) { gps.location.setLongitudeNegative(west); }
+  void speed(int32_t value) { gps.speed.newval = value; }
+  void course(int32_t value) { gps.course.newval = value; }
+  void altitude(int32_t value) { gps.altitude.newval = value; }
+  void satellites(uint32_t value) { gps.satellites.newval = value; }
+  void hdop(int32_t value) { gps.hdop.newval = value; }
+  void pdop(int32_t value) { gps.pdop.newval = value; }
+  void vdop(int32_t value) { gps.vdop.newval = value; }
+  void fixMode(uint32_t value) { gps.fixMode.newval = value; }
+  void active(uint8_t termNumber) {
+    if (gps.satelliteTable != NULL)
+      gps.satelliteTable->setActiveTerm(termNumber, gps.term);
+  }
+  void hasFix(bool hasFix) { gps.sentenceHasFix = hasFix; }
+  void errorStat(uint8_t field, int32_t value) {
+    gps.errorStats.newval[field] = value;
+  }
+};
+
 // static
 /// Parse a (potentially negative) number with up to 2 decimal digits -xxxx.yy
 /// Result is integer value 10*the float value. For example 1234.56 is 123456
@@ -116,18 +718,7 @@ int TinyGPSPlus::fromHex(char a) {
 /// \param term text to parse
 /// \return the decimal value.
 int32_t TinyGPSPlus::parseDecimal(const char *term) {
-  bool negative = *term == '-';
-  if (negative)
-    ++term;
-  int32_t ret = 100 * (int32_t)atol(term);
-  while (isdigit(*term))
-    ++term;
-  if (*term == '.' && isdigit(term[1])) {
-    ret += 10 * (term[1] - '0');
-    if (isdigit(term[2]))
-      ret += term[2] - '0';
-  }
-  return negative ? -ret : ret;
+  return TinyGPSNumeric::parseDecimal(term);
 }
 
 // static
@@ -137,76 +728,190 @@ int32_t TinyGPSPlus::parseDecimal(const char *term) {
 /// \param term input string to parse
 /// \param deg output RawDegrees struct containing parsed term
 void TinyGPSPlus::parseDegrees(const char *term, RawDegrees &deg) {
-  uint32_t leftOfDecimal = (uint32_t)atol(term);
-  uint16_t minutes = (uint16_t)(leftOfDecimal % 100);
-  uint32_t multiplier = 10000000UL;
-  uint32_t tenMillionthsOfMinutes = minutes * multiplier;
-
-  deg.deg = (int16_t)(leftOfDecimal / 100);
-
-  while (isdigit(*term))
-    ++term;
+  TinyGPSNumeric::parseDegrees(term, deg.deg, deg.billionths);
+  deg.negative = false;
+}
 
-  if (*term == '.')
-    while (isdigit(*++term)) {
-      multiplier /= 10;
-      tenMillionthsOfMinutes += (*term - '0') * multiplier;
-    }
+// Maps the address field of a sentence (talker ID followed by sentence
+// formatter, for example "GNRMC") to one of the GPS_SENTENCE_ types.
+// Talker and formatter are each packed into an integer and switched on, so
+// this costs the same for every sentence regardless of how many types or
+// talkers are recognized.
+uint8_t TinyGPSPlus::sentenceType(const char *term) {
+  if (!term[0] || !term[1] || !term[2] || !term[3] || !term[4] || term[5])
+    return GPS_SENTENCE_OTHER;
+
+  switch (_GPS_PACK2(term[0], term[1])) {
+  case _GPS_PACK2('G', 'P'): // GPS
+  case _GPS_PACK2('G', 'N'): // Multi-constellation
+  case _GPS_PACK2('G', 'L'): // GLONASS
+  case _GPS_PACK2('G', 'A'): // Galileo
+  case _GPS_PACK2('G', 'B'): // BeiDou
+  case _GPS_PACK2('B', 'D'): // BeiDou (legacy)
+  case _GPS_PACK2('G', 'Q'): // QZSS
+    break;
+  default:
+    return GPS_SENTENCE_OTHER;
+  }
 
-  deg.billionths = (5 * tenMillionthsOfMinutes + 1) / 3;
-  deg.negative = false;
+  switch (_GPS_PACK3(term[2], term[3], term[4])) {
+  case _GPS_PACK3('R', 'M', 'C'): // Recommended minimum specific GNSS data
+    return GPS_SENTENCE_RMC;
+  case _GPS_PACK3('G', 'G', 'A'): // GNSS fix data
+    return GPS_SENTENCE_GGA;
+  case _GPS_PACK3('G', 'S', 'V'): // GNSS satellites in view
+    return GPS_SENTENCE_GSV;
+  case _GPS_PACK3('G', 'S', 'A'): // GNSS DOP and active satellites
+    return GPS_SENTENCE_GSA;
+  case _GPS_PACK3('V', 'T', 'G'): // Course over ground and ground speed
+    return GPS_SENTENCE_VTG;
+  case _GPS_PACK3('G', 'L', 'L'): // Geographic position
+    return GPS_SENTENCE_GLL;
+  case _GPS_PACK3('Z', 'D', 'A'): // Time and date
+    return GPS_SENTENCE_ZDA;
+  case _GPS_PACK3('G', 'N', 'S'): // GNSS fix data
+    return GPS_SENTENCE_GNS;
+  case _GPS_PACK3('G', 'S', 'T'): // Pseudorange error statistics
+    return GPS_SENTENCE_GST;
+  default:
+    return GPS_SENTENCE_OTHER;
+  }
 }
 
-/// Combine sentence type and term number into a single value
-///
-/// \param sentence_type the sentence type
-/// \param term_number the term number
-#define COMBINE(sentence_type, term_number)                                    \
-  (((unsigned)(sentence_type) << 5) | term_number)
+// The terms of each sentence type; term 0, the address field, is handled
+// separately. GSV sentences are decoded by TinyGPSSatellites.
+const uint8_t TinyGPSPlus::termMap[GPS_SENTENCE_OTHER][MAPPED_TERMS]
+    _GPS_PROGMEM = {
+    // GGA: time, latitude, N/S, longitude, E/W, quality, satellites, HDOP,
+    // altitude
+    {TERM_NONE, TERM_TIME, TERM_LATITUDE, TERM_NORTH_SOUTH, TERM_LONGITUDE,
+     TERM_EAST_WEST, TERM_QUALITY, TERM_SATELLITES, TERM_HDOP, TERM_ALTITUDE},
+    // RMC: time, status, latitude, N/S, longitude, E/W, speed, course, date
+    {TERM_NONE, TERM_TIME, TERM_STATUS, TERM_LATITUDE, TERM_NORTH_SOUTH,
+     TERM_LONGITUDE, TERM_EAST_WEST, TERM_SPEED, TERM_COURSE, TERM_DATE},
+    // GSV
+    {TERM_NONE},
+    // GSA: selection mode, fix mode, 12 PRNs, PDOP, HDOP, VDOP, system ID
+    {TERM_NONE, TERM_NONE, TERM_FIX_MODE, TERM_ACTIVE, TERM_ACTIVE,
+     TERM_ACTIVE, TERM_ACTIVE, TERM_ACTIVE, TERM_ACTIVE, TERM_ACTIVE,
+     TERM_ACTIVE, TERM_ACTIVE, TERM_ACTIVE, TERM_ACTIVE, TERM_ACTIVE,
+     TERM_PDOP, TERM_HDOP, TERM_VDOP, TERM_ACTIVE},
+    // VTG: true course, T, magnetic course, M, speed in knots, N, speed in
+    // km/h, K, mode
+    {TERM_NONE, TERM_COURSE, TERM_NONE, TERM_NONE, TERM_NONE, TERM_VTG_SPEED,
+     TERM_NONE, TERM_NONE, TERM_NONE, TERM_MODE},
+    // GLL: latitude, N/S, longitude, E/W, time, status; the mode that may
+    // follow agrees with the status
+    {TERM_NONE, TERM_LATITUDE, TERM_NORTH_SOUTH, TERM_LONGITUDE,
+     TERM_EAST_WEST, TERM_TIME, TERM_STATUS},
+    // ZDA: time, day, month, year, local zone hours and minutes
+    {TERM_NONE, TERM_TIME, TERM_DAY, TERM_MONTH, TERM_YEAR, TERM_ZONE_HOURS,
+     TERM_ZONE_MINUTES},
+    // GNS: time, latitude, N/S, longitude, E/W, mode per constellation,
+    // satellites, HDOP, altitude
+    {TERM_NONE, TERM_TIME, TERM_LATITUDE, TERM_NORTH_SOUTH, TERM_LONGITUDE,
+     TERM_EAST_WEST, TERM_MODE, TERM_SATELLITES, TERM_HDOP, TERM_ALTITUDE},
+    // GST: time, then the seven TinyGPSErrorStats fields
+    {TERM_NONE, TERM_NONE, TERM_ERROR_STATS, TERM_ERROR_STATS,
+     TERM_ERROR_STATS, TERM_ERROR_STATS, TERM_ERROR_STATS, TERM_ERROR_STATS,
+     TERM_ERROR_STATS},
+};
+
+const TinyGPSPlus::CommitRule TinyGPSPlus::commitMap[GPS_SENTENCE_OTHER]
+    _GPS_PROGMEM = {
+    // GGA
+    {COMMIT_TIME | COMMIT_SATELLITES | COMMIT_HDOP,
+     COMMIT_LOCATION | COMMIT_ALTITUDE},
+    // RMC
+    {COMMIT_DATE | COMMIT_TIME,
+     COMMIT_LOCATION | COMMIT_SPEED | COMMIT_COURSE},
+    // GSV
+    {0, 0},
+    // GSA
+    {COMMIT_FIX_MODE | COMMIT_PDOP | COMMIT_HDOP | COMMIT_VDOP, 0},
+    // VTG
+    {0, COMMIT_SPEED | COMMIT_COURSE},
+    // GLL
+    {COMMIT_TIME, COMMIT_LOCATION},
+    // ZDA
+    {COMMIT_TIME | COMMIT_DATE | COMMIT_TIME_ZONE, 0},
+    // GNS
+    {COMMIT_TIME | COMMIT_SATELLITES | COMMIT_HDOP,
+     COMMIT_LOCATION | COMMIT_ALTITUDE},
+    // GST
+    {COMMIT_ERROR_STATS, 0},
+};
 
 // Processes a just-completed term
 // Returns true if new sentence has just passed checksum test and is validated
-bool TinyGPSPlus::endOfTermHandler() {
+bool TinyGPSPlus::endOfTermHandler(const TinyGPSField *inPlace) {
   // If it's the checksum term, and the checksum checks out, commit
   if (isChecksumTerm) {
-    byte checksum = 16 * fromHex(term[0]) + fromHex(term[1]);
-    if (checksum == parity) {
+    if (checksumMatches(term[0], term[1], parity)) {
       passedChecksumCount++;
       if (sentenceHasFix)
         ++sentencesWithFixCount;
 
-      switch (curSentenceType) {
-      case GPS_SENTENCE_GPRMC:
-        date.commit();
-        time.commit();
-        if (sentenceHasFix) {
-          location.commit();
-          speed.commit();
-          course.commit();
-        }
-        break;
-      case GPS_SENTENCE_GPGGA:
-        time.commit();
-        if (sentenceHasFix) {
-          location.commit();
-          altitude.commit();
-        }
-        satellites.commit();
-        hdop.commit();
-        break;
+      uint32_t now = TinyGPSClock::now();
+      uint16_t fields = 0;
+
+      if (curSentenceType != GPS_SENTENCE_OTHER) {
+        const CommitRule *rule = &commitMap[curSentenceType];
+        fields = _GPS_READ_WORD(&rule->always) |
+                 (sentenceHasFix ? _GPS_READ_WORD(&rule->withFix) : 0);
+        if (fields & COMMIT_LOCATION)
+          location.commit(now);
+        if (fields & COMMIT_DATE)
+          date.commit(now);
+        if (fields & COMMIT_TIME)
+          time.commit(now);
+        if (fields & COMMIT_SPEED)
+          speed.commit(now);
+        if (fields & COMMIT_COURSE)
+          course.commit(now);
+        if (fields & COMMIT_ALTITUDE)
+          altitude.commit(now);
+        if (fields & COMMIT_SATELLITES)
+          satellites.commit(now);
+        if (fields & COMMIT_HDOP)
+          hdop.commit(now);
+        if (fields & COMMIT_FIX_MODE)
+          fixMode.commit(now);
+        if (fields & COMMIT_PDOP)
+          pdop.commit(now);
+        if (fields & COMMIT_VDOP)
+          vdop.commit(now);
+        if (fields & COMMIT_TIME_ZONE)
+          timeZone.commit(now);
+        if (fields & COMMIT_ERROR_STATS)
+          errorStats.commit(now);
+        if ((uint8_t)fields != 0)
+          updateFix((uint8_t)fields, now);
+      }
+
+      if (satelliteTable != NULL) {
+        if (curSentenceType == GPS_SENTENCE_GSV)
+          satelliteTable->commitMessage(curTermNumber, now);
+        else if (curSentenceType == GPS_SENTENCE_GSA)
+          satelliteTable->commitActive();
       }
 
       // Commit all custom listeners of this sentence type
-      for (TinyGPSCustom *p = customCandidates;
-           p != NULL &&
-           strcmp(p->sentenceName, customCandidates->sentenceName) == 0;
-           p = p->next)
-        p->commit();
+      if (customCandidates != NULL)
+        for (TinyGPSCustom *p = customCandidates;
+             p != customCandidates->nextSentence; p = p->next)
+          p->commit(now);
+
+#if _GPS_MAX_LISTENERS > 0
+      if (listenerCount != 0)
+        notify(curSentenceType, fields, now);
+#endif
       return true;
     }
 
     else {
       ++failedChecksumCount;
+      discardSentence();
     }
 
     return false;
@@ -214,82 +919,52 @@ bool TinyGPSPlus::endOfTermHandler() {
 
   // the first term determines the sentence type
   if (curTermNumber == 0) {
-    if (!strcmp(term, _GPRMCterm) || !strcmp(term, _GNRMCterm))
-      curSentenceType = GPS_SENTENCE_GPRMC;
-    else if (!strcmp(term, _GPGGAterm) || !strcmp(term, _GNGGAterm))
-      curSentenceType = GPS_SENTENCE_GPGGA;
-    else
-      curSentenceType = GPS_SENTENCE_OTHER;
+    curSentenceType = sentenceType(term);
+    if (satelliteTable != NULL) {
+      if (curSentenceType == GPS_SENTENCE_GSV)
+        satelliteTable->beginMessage(term);
+      satelliteTable->beginActive(term, curSentenceType == GPS_SENTENCE_GSA);
+    }
 
-    // Any custom candidates of this sentence type?
+    // Any custom candidates of this sentence type? Only the first element
+    // of each sentence is visited, and names only compared when they are
+    // too long for the key.
+    uint64_t key = customKey(term);
     for (customCandidates = customElts;
          customCandidates != NULL &&
-         strcmp(customCandidates->sentenceName, term) < 0;
-         customCandidates = customCandidates->next)
+         (customCandidates->sentenceKey != key ||
+          (curTermOffset >= 8 &&
+           strcmp(customCandidates->sentenceName, term) != 0));
+         customCandidates = customCandidates->nextSentence)
       ;
-    if (customCandidates != NULL &&
-        strcmp(customCandidates->sentenceName, term) > 0)
-      customCandidates = NULL;
+    customCursor = customCandidates;
 
     return false;
   }
 
-  if (curSentenceType != GPS_SENTENCE_OTHER && term[0])
-    switch (COMBINE(curSentenceType, curTermNumber)) {
-    case COMBINE(GPS_SENTENCE_GPRMC, 1): // Time in both sentences
-    case COMBINE(GPS_SENTENCE_GPGGA, 1):
-      time.setTime(term);
-      break;
-    case COMBINE(GPS_SENTENCE_GPRMC, 2): // GPRMC validity
-      sentenceHasFix = term[0] == 'A';
-      break;
-    case COMBINE(GPS_SENTENCE_GPRMC, 3): // Latitude
-    case COMBINE(GPS_SENTENCE_GPGGA, 2):
-      location.setLatitude(term);
-      break;
-    case COMBINE(GPS_SENTENCE_GPRMC, 4): // N/S
-    case COMBINE(GPS_SENTENCE_GPGGA, 3):
-      location.setLatitudeNegative(term[0] == 'S');
-      break;
-    case COMBINE(GPS_SENTENCE_GPRMC, 5): // Longitude
-    case COMBINE(GPS_SENTENCE_GPGGA, 4):
-      location.setLongitude(term);
-      break;
-    case COMBINE(GPS_SENTENCE_GPRMC, 6): // E/W
-    case COMBINE(GPS_SENTENCE_GPGGA, 5):
-      location.setLongitudeNegative(term[0] == 'W');
-      break;
-    case COMBINE(GPS_SENTENCE_GPRMC, 7): // Speed (GPRMC)
-      speed.set(term);
-      break;
-    case COMBINE(GPS_SENTENCE_GPRMC, 8): // Course (GPRMC)
-      course.set(term);
-      break;
-    case COMBINE(GPS_SENTENCE_GPRMC, 9): // Date (GPRMC)
-      date.setDate(term);
-      break;
-    case COMBINE(GPS_SENTENCE_GPGGA, 6): // Fix data (GPGGA)
-      sentenceHasFix = term[0] > '0';
-      break;
-    case COMBINE(GPS_SENTENCE_GPGGA, 7): // Satellites used (GPGGA)
-      satellites.set(term);
-      break;
-    case COMBINE(GPS_SENTENCE_GPGGA, 8): // HDOP
-      hdop.set(term);
-      break;
-    case COMBINE(GPS_SENTENCE_GPGGA, 9): // Altitude (GPGGA)
-      altitude.set(term);
-      break;
-    }
+  if (curSentenceType == GPS_SENTENCE_GSV) {
+    if (satelliteTable != NULL)
+      satelliteTable->setTerm(curTermNumber, term);
+  } else {
+    // The length is known, which spares the numeric parsers a strlen()
+    TermSink sink = {*this};
+    decodeTerm(curSentenceType, curTermNumber,
+               TinyGPSField(term, curTermOffset), sink);
+  }
 
-  // Set custom values as needed
-  for (TinyGPSCustom *p = customCandidates;
-       p != NULL &&
-       strcmp(p->sentenceName, customCandidates->sentenceName) == 0 &&
-       p->termNumber <= curTermNumber;
-       p = p->next)
-    if (p->termNumber == curTermNumber)
-      p->set(term);
+  // Set custom values as needed. Terms arrive in order and the candidates
+  // are sorted by term number, so the cursor only ever moves forward.
+  if (customCandidates != NULL) {
+    TinyGPSCustom *last = customCandidates->nextSentence;
+    while (customCursor != last && customCursor->termNumber < curTermNumber)
+      customCursor = customCursor->next;
+    for (; customCursor != last && customCursor->termNumber == curTermNumber;
+         customCursor = customCursor->next)
+      if (inPlace != NULL)
+        customCursor->set(*inPlace);
+      else
+        customCursor->set(term);
+  }
 
   return false;
 }
@@ -302,18 +977,18 @@ double TinyGPSPlus::distanceBetween(double lat1, double long1, double lat2,
   // distance computation for hypothetical sphere of radius 6372795 meters.
   // Because Earth is no exact sphere, rounding errors may be up to 0.5%.
   // Courtesy of Maarten Lamers
-  double delta = radians(long1 - long2);
+  double delta = (long1 - long2) * _GPS_DEG_TO_RAD;
   double sd_long = sin(delta);
   double cd_long = cos(delta);
-  lat1 = radians(lat1);
-  lat2 = radians(lat2);
+  lat1 = lat1 * _GPS_DEG_TO_RAD;
+  lat2 = lat2 * _GPS_DEG_TO_RAD;
   double slat1 = sin(lat1);
   double c_lat1 = cos(lat1);
   double slat2 = sin(lat2);
   double c_lat2 = cos(lat2);
   delta = (c_lat1 * slat2) - (slat1 * c_lat2 * cd_long);
-  delta = sq(delta);
-  delta += sq(c_lat2 * sd_long);
+  delta = delta * delta;
+  delta += (c_lat2 * sd_long) * (c_lat2 * sd_long);
   delta = sqrt(delta);
   double denom = (slat1 * slat2) + (c_lat1 * c_lat2 * cd_long);
   delta = atan2(delta, denom);
@@ -326,17 +1001,17 @@ double TinyGPSPlus::courseTo(double lat1, double long1, double lat2,
   // 2, both specified as signed decimal-degrees latitude and longitude. Because
   // Earth is no exact sphere, calculated course may be off by a tiny fraction.
   // Courtesy of Maarten Lamers
-  double d_lon = radians(long2 - long1);
-  lat1 = radians(lat1);
-  lat2 = radians(lat2);
+  double d_lon = (long2 - long1) * _GPS_DEG_TO_RAD;
+  lat1 = lat1 * _GPS_DEG_TO_RAD;
+  lat2 = lat2 * _GPS_DEG_TO_RAD;
   double a1 = sin(d_lon) * cos(lat2);
   double a2 = sin(lat1) * cos(lat2) * cos(d_lon);
   a2 = cos(lat1) * sin(lat2) - a2;
   a2 = atan2(a1, a2);
   if (a2 < 0.0) {
-    a2 += TWO_PI;
+    a2 += _GPS_TWO_PI;
   }
-  return degrees(a2);
+  return a2 * _GPS_RAD_TO_DEG;
 }
 
 const char *TinyGPSPlus::cardinal(double course) {
@@ -347,10 +1022,41 @@ const char *TinyGPSPlus::cardinal(double course) {
   return directions[direction % 16];
 }
 
-void TinyGPSLocation::commit() {
+bool TinyGPSField::equals(const char *s) const {
+  return strncmp(text, s, length) == 0 && s[length] == '\0';
+}
+
+size_t TinyGPSField::copy(char *buffer, size_t capacity) const {
+  size_t n = length < capacity - 1 ? length : capacity - 1;
+  memcpy(buffer, text, n);
+  buffer[n] = '\0';
+  return n;
+}
+
+// Numbers are parsed in place, truncated like a term copied by encode().
+// Longer numbers are not meaningful in NMEA anyway.
+uint32_t TinyGPSField::toUnsigned() const {
+  const char *p = text;
+  return TinyGPSNumeric::parseUnsigned(p, numberEnd());
+}
+
+int32_t TinyGPSField::toDecimal() const {
+  return TinyGPSNumeric::parseDecimal(text, numberEnd());
+}
+
+int32_t TinyGPSField::toThousandths() const {
+  return TinyGPSNumeric::parseThousandths(text, numberEnd());
+}
+
+void TinyGPSField::toDegrees(RawDegrees &deg) const {
+  TinyGPSNumeric::parseDegrees(text, numberEnd(), deg.deg, deg.billionths);
+  deg.negative = false;
+}
+
+void TinyGPSLocation::commit(uint32_t now) {
   rawLatData = rawNewLatData;
   rawLngData = rawNewLngData;
-  lastCommitTime = millis();
+  lastCommitTime = now;
   valid = updated = true;
 }
 
@@ -364,73 +1070,83 @@ void TinyGPSLocation::setLongitude(const char *term) {
 
 double TinyGPSLocation::lat() {
   updated = false;
-  double ret = rawLatData.deg + rawLatData.billionths / 1000000000.0;
-  return rawLatData.negative ? -ret : ret;
+  return static_cast<const TinyGPSLocation &>(*this).lat();
 }
 
 double TinyGPSLocation::lng() {
   updated = false;
+  return static_cast<const TinyGPSLocation &>(*this).lng();
+}
+
+double TinyGPSLocation::lat() const {
+  double ret = rawLatData.deg + rawLatData.billionths / 1000000000.0;
+  return rawLatData.negative ? -ret : ret;
+}
+
+double TinyGPSLocation::lng() const {
   double ret = rawLngData.deg + rawLngData.billionths / 1000000000.0;
   return rawLngData.negative ? -ret : ret;
 }
 
-void TinyGPSDate::commit() {
+void TinyGPSDate::commit(uint32_t now) {
   date = newDate;
-  lastCommitTime = millis();
+  fullYear = newFullYear;
+  lastCommitTime = now;
   valid = updated = true;
 }
 
-void TinyGPSTime::commit() {
+void TinyGPSTime::commit(uint32_t now) {
   time = newTime;
-  lastCommitTime = millis();
+  lastCommitTime = now;
   valid = updated = true;
 }
 
-void TinyGPSTime::setTime(const char *term) {
-  newTime = (uint32_t)TinyGPSPlus::parseDecimal(term);
+void TinyGPSTimeZone::commit(uint32_t now) {
+  minutes = newHours * 60 + newMinutes;
+  if (newNegative)
+    minutes = -minutes;
+  lastCommitTime = now;
+  valid = updated = true;
 }
 
-void TinyGPSDate::setDate(const char *term) { newDate = atol(term); }
-
 uint16_t TinyGPSDate::year() {
   updated = false;
-  uint16_t year = date % 100;
-  return year + 2000;
+  return static_cast<const TinyGPSDate &>(*this).year();
 }
 
 uint8_t TinyGPSDate::month() {
   updated = false;
-  return (date / 100) % 100;
+  return static_cast<const TinyGPSDate &>(*this).month();
 }
 
 uint8_t TinyGPSDate::day() {
   updated = false;
-  return date / 10000;
+  return static_cast<const TinyGPSDate &>(*this).day();
 }
 
 uint8_t TinyGPSTime::hour() {
   updated = false;
-  return time / 1000000;
+  return static_cast<const TinyGPSTime &>(*this).hour();
 }
 
 uint8_t TinyGPSTime::minute() {
   updated = false;
-  return (time / 10000) % 100;
+  return static_cast<const TinyGPSTime &>(*this).minute();
 }
 
 uint8_t TinyGPSTime::second() {
   updated = false;
-  return (time / 100) % 100;
+  return static_cast<const TinyGPSTime &>(*this).second();
 }
 
 uint8_t TinyGPSTime::centisecond() {
   updated = false;
-  return time % 100;
+  return static_cast<const TinyGPSTime &>(*this).centisecond();
 }
 
-void TinyGPSDecimal::commit() {
+void TinyGPSDecimal::commit(uint32_t now) {
   val = newval;
-  lastCommitTime = millis();
+  lastCommitTime = now;
   valid = updated = true;
 }
 
@@ -438,13 +1154,22 @@ void TinyGPSDecimal::set(const char *term) {
   newval = TinyGPSPlus::parseDecimal(term);
 }
 
-void TinyGPSInteger::commit() {
+void TinyGPSErrorStats::commit(uint32_t now) {
+  for (uint8_t i = 0; i < FIELDS; ++i)
+    val[i] = newval[i];
+  lastCommitTime = now;
+  valid = updated = true;
+}
+
+void TinyGPSInteger::commit(uint32_t now) {
   val = newval;
-  lastCommitTime = millis();
+  lastCommitTime = now;
   valid = updated = true;
 }
 
-void TinyGPSInteger::set(const char *term) { newval = atol(term); }
+void TinyGPSInteger::set(const char *term) {
+  newval = TinyGPSNumeric::parseUnsigned(term);
+}
 
 TinyGPSCustom::TinyGPSCustom(TinyGPSPlus &gps, const char *_sentenceName,
                              int _termNumber) {
@@ -456,34 +1181,87 @@ void TinyGPSCustom::begin(TinyGPSPlus &gps, const char *_sentenceName,
   lastCommitTime = 0;
   updated = valid = false;
   sentenceName = _sentenceName;
+  sentenceKey = TinyGPSPlus::customKey(_sentenceName);
   termNumber = _termNumber;
   memset(stagingBuffer, '\0', sizeof(stagingBuffer));
   memset(buffer, '\0', sizeof(buffer));
+  staged = STAGED_COPY;
 
   // Insert this item into the GPS tree
-  gps.insertCustom(this, _sentenceName, _termNumber);
+  gps.insertCustom(this);
 }
 
-void TinyGPSCustom::commit() {
-  strcpy(this->buffer, this->stagingBuffer);
-  lastCommitTime = millis();
+void TinyGPSCustom::commit(uint32_t now) {
+  if (staged == STAGED_COPY) {
+    strcpy(this->buffer, this->stagingBuffer);
+  } else if (staged == STAGED_FIELD) {
+    // Truncated like a copied term; the value stays staged for commits by
+    // later sentences that lack this term
+    stagedField.copy(this->buffer, _GPS_MAX_FIELD_SIZE);
+    staged = STAGED_COMMITTED;
+  }
+  lastCommitTime = now;
   valid = updated = true;
 }
 
 void TinyGPSCustom::set(const char *term) {
   strncpy(this->stagingBuffer, term, sizeof(this->stagingBuffer));
+  staged = STAGED_COPY;
 }
 
-void TinyGPSPlus::insertCustom(TinyGPSCustom *pElt, const char *sentenceName,
-                               int termNumber) {
-  TinyGPSCustom **pPelt;
+void TinyGPSCustom::set(const TinyGPSField &term) {
+  stagedField = term;
+  staged = STAGED_FIELD;
+}
+
+// Packs up to the first eight characters of a sentence name into an integer.
+// Names shorter than eight characters compare equal exactly when their keys
+// do; longer names also need a strcmp() once the keys match.
+uint64_t TinyGPSPlus::customKey(const char *sentenceName) {
+  uint64_t key = 0;
+  for (int i = 0; i < 8 && sentenceName[i]; ++i)
+    key |= (uint64_t)(uint8_t)sentenceName[i] << (8 * i);
+  return key;
+}
 
-  for (pPelt = &this->customElts; *pPelt != NULL; pPelt = &(*pPelt)->next) {
-    int cmp = strcmp(sentenceName, (*pPelt)->sentenceName);
-    if (cmp < 0 || (cmp == 0 && termNumber < (*pPelt)->termNumber))
+// Orders custom elements by sentence, by key first and by name only when
+// the names are too long for the key
+int TinyGPSPlus::customCompare(const TinyGPSCustom *a,
+                               const TinyGPSCustom *b) {
+  if (a->sentenceKey != b->sentenceKey)
+    return a->sentenceKey < b->sentenceKey ? -1 : 1;
+  return (a->sentenceKey >> 56) ? strcmp(a->sentenceName, b->sentenceName)
+                                : 0;
+}
+
+void TinyGPSPlus::insertCustom(TinyGPSCustom *pElt) {
+  // Find the insertion point, remembering the element before it and the
+  // first element of that element's sentence
+  TinyGPSCustom **pPelt = &this->customElts;
+  TinyGPSCustom *prev = NULL, *prevFirst = NULL;
+  int cmp = 1, prevCmp = 1;
+  for (; *pPelt != NULL; pPelt = &(*pPelt)->next) {
+    cmp = customCompare(pElt, *pPelt);
+    if (cmp < 0 || (cmp == 0 && pElt->termNumber < (*pPelt)->termNumber))
       break;
+    if (prev == NULL || prev->nextSentence == *pPelt)
+      prevFirst = *pPelt;
+    prev = *pPelt;
+    prevCmp = cmp;
+    cmp = 1;
   }
 
-  pElt->next = *pPelt;
+  TinyGPSCustom *next = *pPelt;
+  pElt->next = next;
   *pPelt = pElt;
+
+  // Keep every element linked to the first element of the next sentence,
+  // so the sentences can be searched and walked without comparing names
+  if (prev != NULL && prevCmp == 0) {
+    pElt->nextSentence = prev->nextSentence;
+  } else {
+    pElt->nextSentence = cmp == 0 ? next->nextSentence : next;
+    for (TinyGPSCustom *p = prevFirst; p != NULL && p != pElt; p = p->next)
+      p->nextSentence = pElt;
+  }
 }
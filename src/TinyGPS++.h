@@ -30,11 +30,22 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 
 #if defined(ARDUINO) && ARDUINO >= 100
 #include <Arduino.h> // Include the Arduino library
-#else
+#elif defined(ARDUINO)
 // #include "WProgram.h"
 #endif
+#include "TinyGPSConfig.h"
 #include <cstdint>
 #include <limits.h>
+#include <stddef.h>
+#if !_GPS_NO_UBX
+#include "TinyGPSUBX.h"
+#endif
+#if !_GPS_NO_RTCM
+#include "TinyGPSRTCM.h"
+#endif
+#if defined(_GPS_HOST_BUILD) && __cplusplus >= 201703L
+#include <string_view>
+#endif
 
 #define _GPS_VERSION "2.0.0-a1"            ///< software version of this library
 #define _GPS_MPH_PER_KNOT 1.15077945       ///< MPH per knot
@@ -45,6 +56,55 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
 #define _GPS_FEET_PER_METER 3.2808399      ///< Feet per meter
 #define _GPS_MAX_FIELD_SIZE 15             ///< Maximum field size
 
+/// \brief Function returning the current time in milliseconds
+typedef uint32_t (*TinyGPSClockSource)();
+
+/// \brief Millisecond clock used to timestamp commits and compute ages
+///
+/// Defaults to millis() on Arduino and to std::chrono::steady_clock on host
+/// builds. The parser reads it once per validated sentence and stamps every
+/// field committed by that sentence with the same time.
+class TinyGPSClock {
+public:
+  /// Get the current time.
+  /// \return the held time if hold() is in effect, otherwise the time from
+  /// the clock source.
+  static uint32_t now() { return held ? heldTime : source(); }
+
+  /// Replace the clock source, for example with a fake clock in tests.
+  /// \param newSource the new clock source, or NULL for the default clock.
+  static void setSource(TinyGPSClockSource newSource) {
+    source = newSource ? newSource : defaultSource;
+  }
+
+  /// Freeze the clock at a given time, for example the arrival time of a
+  /// batch of data, until release() is called. On host builds the held time
+  /// is per thread.
+  /// \param time time in milliseconds
+  static void hold(uint32_t time) {
+    heldTime = time;
+    held = true;
+  }
+
+  /// Resume reading the clock source after hold().
+  static void release() { held = false; }
+
+  /// The default clock source: millis() on Arduino, milliseconds of
+  /// std::chrono::steady_clock on host builds.
+  /// \return the current time in milliseconds
+  static uint32_t defaultSource();
+
+private:
+  static TinyGPSClockSource source;
+#ifdef _GPS_HOST_BUILD
+  static thread_local bool held;
+  static thread_local uint32_t heldTime;
+#else
+  static bool held;
+  static uint32_t heldTime;
+#endif
+};
+
 /// \brief stuct for NMEA format degrees
 /// Struct to hold degrees in the National Marine Electronics Association (NMEA)
 /// format
@@ -60,8 +120,84 @@ public:
   RawDegrees() : deg(0), billionths(0), negative(false) {}
 };
 
+/// \brief Zero-copy view of one term of an NMEA sentence
+///
+/// Points into the caller's buffer, so the text is not NUL-terminated and
+/// the view is valid only as long as that buffer. There is no length limit.
+class TinyGPSField {
+public:
+  /// Constructor for an empty field
+  TinyGPSField() : text(""), length(0) {}
+
+  /// Constructor
+  /// \param _text first character of the field
+  /// \param _length number of characters in the field
+  TinyGPSField(const char *_text, size_t _length)
+      : text(_text), length(_length) {}
+
+  /// First character of the field, not NUL-terminated
+  /// \return pointer into the caller's buffer
+  const char *data() const { return text; }
+
+  /// Length of the field
+  /// \return number of characters
+  size_t size() const { return length; }
+
+  /// Query if the field is empty.
+  /// \return true if the field has no characters.
+  bool empty() const { return length == 0; }
+
+  /// Get a character of the field.
+  /// \param i index, less than size()
+  /// \return the character
+  char operator[](size_t i) const { return text[i]; }
+
+  /// Compare the field with a NUL-terminated string.
+  /// \param s string to compare with
+  /// \return true if both hold the same characters.
+  bool equals(const char *s) const;
+
+  /// Copy the field into a NUL-terminated buffer, truncating it if needed.
+  /// \param buffer destination
+  /// \param capacity size of buffer, at least 1
+  /// \return number of characters copied, not counting the NUL.
+  size_t copy(char *buffer, size_t capacity) const;
+
+  /// Parse the field as TinyGPSNumeric::parseUnsigned() does.
+  /// \return the value
+  uint32_t toUnsigned() const;
+
+  /// Parse the field as TinyGPSPlus::parseDecimal() does.
+  /// \return 100 times the value
+  int32_t toDecimal() const;
+
+  /// Parse the field as TinyGPSNumeric::parseThousandths() does.
+  /// \return 1000 times the value
+  int32_t toThousandths() const;
+
+  /// Parse the field as TinyGPSPlus::parseDegrees() does.
+  /// \param deg set to the degrees, never negative
+  void toDegrees(RawDegrees &deg) const;
+
+#if defined(_GPS_HOST_BUILD) && __cplusplus >= 201703L
+  /// View of the field as a std::string_view
+  operator std::string_view() const { return std::string_view(text, length); }
+#endif
+
+private:
+  // Numbers are parsed from at most the characters encode() keeps of a term
+  const char *numberEnd() const {
+    const size_t kept = _GPS_MAX_FIELD_SIZE - 1;
+    return text + (length < kept ? length : kept);
+  }
+
+  const char *text;
+  size_t length;
+};
+
 /// \brief GPS Location
 class TinyGPSLocation {
+  friend class TinyGPSPlus;
 
 public:
   /// Query if the location data is valid.
@@ -77,7 +213,7 @@ public:
   /// \return age in milliseconds if valid. ULONG_MAX otherwise.
 
   uint32_t age() const {
-    return valid ? millis() - lastCommitTime : (uint32_t)ULONG_MAX;
+    return valid ? TinyGPSClock::now() - lastCommitTime : (uint32_t)ULONG_MAX;
   }
 
   /// Get the raw latitude
@@ -85,7 +221,7 @@ public:
   /// \return the latitude
   const RawDegrees &rawLat() {
     updated = false;
-    return rawLatData;
+    return static_cast<const TinyGPSLocation &>(*this).rawLat();
   }
 
   /// Get the raw longitude
@@ -93,7 +229,7 @@ public:
   /// \return the longitude
   const RawDegrees &rawLng() {
     updated = false;
-    return rawLngData;
+    return static_cast<const TinyGPSLocation &>(*this).rawLng();
   }
 
   /// Get the latitude
@@ -106,13 +242,36 @@ public:
   /// \return the longitude
   double lng();
 
+  /// Get the raw latitude without marking the data as not updated.
+  /// \return the latitude
+  const RawDegrees &rawLat() const { return rawLatData; }
+
+  /// Get the raw longitude without marking the data as not updated.
+  /// \return the longitude
+  const RawDegrees &rawLng() const { return rawLngData; }
+
+  /// Get the latitude without marking the data as not updated.
+  /// \return the latitude
+  double lat() const;
+
+  /// Get the longitude without marking the data as not updated.
+  /// \return the longitude
+  double lng() const;
+
+  /// Mark the data as not updated, as the non-const getters do.
+  void consume() { updated = false; }
+
   /// Constructor
   TinyGPSLocation()
       : valid(false), updated(false), rawLatData(), rawLngData(),
         rawNewLatData(), rawNewLngData(), lastCommitTime() {}
 
   /// Commit changes
-  void commit();
+  void commit() { commit(TinyGPSClock::now()); }
+
+  /// Commit changes
+  /// \param now commit time in milliseconds
+  void commit(uint32_t now);
 
   /// Set the latitude by parsing the input string
   /// \param term string containing the latitude
@@ -154,7 +313,7 @@ public:
   /// Get the age of the date in miliseconds.
   /// \return age in milliseconds if valid. ULONG_MAX otherwise.
   uint32_t age() const {
-    return valid ? millis() - lastCommitTime : (uint32_t)ULONG_MAX;
+    return valid ? TinyGPSClock::now() - lastCommitTime : (uint32_t)ULONG_MAX;
   }
 
   /// Access the date value and mark it as no longer
@@ -162,10 +321,11 @@ public:
   /// \return date
   uint32_t value() {
     updated = false;
-    return date;
+    return static_cast<const TinyGPSDate &>(*this).value();
   }
 
-  /// Extract the year and mark it as no longer updated.
+  /// Extract the year and mark it as no longer updated. RMC sends two
+  /// digits, taken as 2000 to 2099; ZDA sends all four.
   /// \return year
   uint16_t year();
 
@@ -177,16 +337,85 @@ public:
   /// \return day of month
   uint8_t day();
 
+  /// Access the date value without marking it as not updated.
+  /// \return date
+  uint32_t value() const { return date; }
+
+  /// Extract the year without marking it as not updated.
+  /// \return year
+  uint16_t year() const { return fullYear; }
+
+  /// Extract the month without marking it as not updated.
+  /// \return month
+  uint8_t month() const { return (date / 100) % 100; }
+
+  /// Extract day of month without marking it as not updated.
+  /// \return day of month
+  uint8_t day() const { return date / 10000; }
+
+  /// Mark the date as not updated, as the non-const getters do.
+  void consume() { updated = false; }
+
   /// Constructor
   TinyGPSDate()
-      : valid(false), updated(false), date(0), newDate(), lastCommitTime() {}
+      : valid(false), updated(false), date(0), newDate(), lastCommitTime(),
+        fullYear(2000), newFullYear(2000) {}
 
 private:
   bool valid, updated;
   uint32_t date, newDate;
   uint32_t lastCommitTime;
-  void commit();
-  void setDate(const char *term);
+  uint16_t fullYear, newFullYear;
+  void commit(uint32_t now);
+};
+
+/// \brief Class to hold the local time zone sent in ZDA sentences
+class TinyGPSTimeZone {
+  friend class TinyGPSPlus;
+
+public:
+  /// Query if the time zone is valid.
+  /// \return true if valid false otherwise.
+  bool isValid() const { return valid; }
+
+  /// Query if the time zone has been updated.
+  /// \return true if updated false otherwise.
+  bool isUpdated() const { return updated; }
+
+  /// Get the age of the time zone in milliseconds
+  /// \return age in milliseconds if valid. ULONG_MAX otherwise.
+  uint32_t age() const {
+    return valid ? TinyGPSClock::now() - lastCommitTime : (uint32_t)ULONG_MAX;
+  }
+
+  /// Get the local zone as sent and mark it as not updated. NMEA 0183
+  /// defines it as the time to add to local time to get UTC, but receivers
+  /// differ and most send zero.
+  /// \return zone hours and minutes, in minutes
+  int16_t offset() {
+    updated = false;
+    return static_cast<const TinyGPSTimeZone &>(*this).offset();
+  }
+
+  /// Get the local zone as sent without marking it as not updated.
+  /// \return zone hours and minutes, in minutes
+  int16_t offset() const { return minutes; }
+
+  /// Mark the time zone as not updated, as offset() does.
+  void consume() { updated = false; }
+
+  /// Constructor
+  TinyGPSTimeZone()
+      : valid(false), updated(false), minutes(0), newHours(0), newMinutes(0),
+        newNegative(false), lastCommitTime() {}
+
+private:
+  bool valid, updated;
+  int16_t minutes;
+  uint8_t newHours, newMinutes;
+  bool newNegative;
+  uint32_t lastCommitTime;
+  void commit(uint32_t now);
 };
 
 /// \brief Class to hold GPS time
@@ -205,14 +434,14 @@ public:
   /// Get the age of the time data in milliseconds
   /// \return age in milliseconds if valid. ULONG_MAX otherwise.
   uint32_t age() const {
-    return valid ? millis() - lastCommitTime : (uint32_t)ULONG_MAX;
+    return valid ? TinyGPSClock::now() - lastCommitTime : (uint32_t)ULONG_MAX;
   }
 
   /// Get the integral value storing the time and mark it as not updated.
   /// \return the time.
   uint32_t value() {
     updated = false;
-    return time;
+    return static_cast<const TinyGPSTime &>(*this).value();
   }
 
   /// Get the hour and mark it as not updated.
@@ -231,6 +460,30 @@ public:
   /// \return hundredths of seconds.
   uint8_t centisecond();
 
+  /// Get the integral value storing the time without marking it as not
+  /// updated.
+  /// \return the time.
+  uint32_t value() const { return time; }
+
+  /// Get the hour without marking it as not updated.
+  /// \return the hour.
+  uint8_t hour() const { return time / 1000000; }
+
+  /// Get the minute without marking it as not updated.
+  /// \return the minute
+  uint8_t minute() const { return (time / 10000) % 100; }
+
+  /// Get the second without marking it as not updated.
+  /// \return the second.
+  uint8_t second() const { return (time / 100) % 100; }
+
+  /// Get hundredths of a second without marking them as not updated.
+  /// \return hundredths of seconds.
+  uint8_t centisecond() const { return time % 100; }
+
+  /// Mark the time as not updated, as the non-const getters do.
+  void consume() { updated = false; }
+
   /// Constructor
   TinyGPSTime()
       : valid(false), updated(false), time(0), newTime(), lastCommitTime() {}
@@ -239,8 +492,7 @@ private:
   bool valid, updated;
   uint32_t time, newTime;
   uint32_t lastCommitTime;
-  void commit();
-  void setTime(const char *term);
+  void commit(uint32_t now);
 };
 
 /// \brief Class to hold GPS decimal value
@@ -248,7 +500,7 @@ private:
 /// integer value 10*the float value. For example 1234.56 is 123456
 /// -1234.56 is -123456.
 class TinyGPSDecimal {
-  // friend class TinyGPSPlus;
+  friend class TinyGPSPlus;
 
 public:
   /// Query if the decimal data is valid.
@@ -262,22 +514,33 @@ public:
   /// Get the age of the decimal data in milliseconds
   /// \return age in milliseconds if valid. ULONG_MAX otherwise.
   uint32_t age() const {
-    return valid ? millis() - lastCommitTime : (uint32_t)ULONG_MAX;
+    return valid ? TinyGPSClock::now() - lastCommitTime : (uint32_t)ULONG_MAX;
   }
 
   /// Get the value of the decimal data and mark it as not updated.
   /// \return the decimal value.
   int32_t value() {
     updated = false;
-    return val;
+    return static_cast<const TinyGPSDecimal &>(*this).value();
   }
 
+  /// Get the value of the decimal data without marking it as not updated.
+  /// \return the decimal value.
+  int32_t value() const { return val; }
+
+  /// Mark the data as not updated, as value() does.
+  void consume() { updated = false; }
+
   /// Constructor
   TinyGPSDecimal()
       : valid(false), updated(false), lastCommitTime(), val(0), newval() {}
 
   /// Commit changes
-  void commit();
+  void commit() { commit(TinyGPSClock::now()); }
+
+  /// Commit changes
+  /// \param now commit time in milliseconds
+  void commit(uint32_t now);
 
   /// Set the data from input string.
   /// \param term the input string
@@ -292,6 +555,8 @@ private:
 
 /// \brief Class to hold a 32 bit integer value
 class TinyGPSInteger {
+  friend class TinyGPSPlus;
+
 public:
   /// Query if the data is valid.
   /// \return true if valid false otherwise.
@@ -304,26 +569,37 @@ public:
   /// Get the age of the data in milliseconds
   /// \return age in milliseconds if valid. ULONG_MAX otherwise.
   uint32_t age() const {
-    return valid ? millis() - lastCommitTime : (uint32_t)ULONG_MAX;
+    return valid ? TinyGPSClock::now() - lastCommitTime : (uint32_t)ULONG_MAX;
   }
 
   /// Get the value of the data and mark it as not updated.
   /// \return the decimal value.
   uint32_t value() {
     updated = false;
-    return val;
+    return static_cast<const TinyGPSInteger &>(*this).value();
   }
 
+  /// Get the value of the data without marking it as not updated.
+  /// \return the value.
+  uint32_t value() const { return val; }
+
+  /// Mark the data as not updated, as value() does.
+  void consume() { updated = false; }
+
   /// Constructor
   TinyGPSInteger()
       : valid(false), updated(false), lastCommitTime(), val(0), newval() {}
 
   /// Commit changes
-  void commit();
+  void commit() { commit(TinyGPSClock::now()); }
+
+  /// Commit changes
+  /// \param now commit time in milliseconds
+  void commit(uint32_t now);
 
   /// Set the data from input string.
   /// \param term the input string
-  /// uses atol to interpret term
+  /// uses TinyGPSNumeric::parseUnsigned to interpret term
   void set(const char *term);
 
 private:
@@ -337,19 +613,47 @@ class TinyGPSSpeed : public TinyGPSDecimal {
 public:
   /// Return speed in knots.
   /// \return speed in knots.
-  double knots() { return value() / 100.0; }
+  double knots() {
+    consume();
+    return static_cast<const TinyGPSSpeed &>(*this).knots();
+  }
 
   /// Return speed in miles per hour.
   /// \return speed in mph.
-  double mph() { return _GPS_MPH_PER_KNOT * value() / 100.0; }
+  double mph() {
+    consume();
+    return static_cast<const TinyGPSSpeed &>(*this).mph();
+  }
 
   /// Return speed in meters per second.
   /// \return speed in meters per second.
-  double mps() { return _GPS_MPS_PER_KNOT * value() / 100.0; }
+  double mps() {
+    consume();
+    return static_cast<const TinyGPSSpeed &>(*this).mps();
+  }
 
   /// Return speed in kilometers per hour.
   /// \return speed in kilometers per hour.
-  double kmph() { return _GPS_KMPH_PER_KNOT * value() / 100.0; }
+  double kmph() {
+    consume();
+    return static_cast<const TinyGPSSpeed &>(*this).kmph();
+  }
+
+  /// Return speed in knots without marking it as not updated.
+  /// \return speed in knots.
+  double knots() const { return value() / 100.0; }
+
+  /// Return speed in miles per hour without marking it as not updated.
+  /// \return speed in mph.
+  double mph() const { return _GPS_MPH_PER_KNOT * value() / 100.0; }
+
+  /// Return speed in meters per second without marking it as not updated.
+  /// \return speed in meters per second.
+  double mps() const { return _GPS_MPS_PER_KNOT * value() / 100.0; }
+
+  /// Return speed in kilometers per hour without marking it as not updated.
+  /// \return speed in kilometers per hour.
+  double kmph() const { return _GPS_KMPH_PER_KNOT * value() / 100.0; }
 };
 
 /// \brief Class to hold GPS course
@@ -362,7 +666,14 @@ public:
    * @return The value returned by the `value` function divided by 100.0,
    * representing degrees.
    */
-  double deg() { return value() / 100.0; }
+  double deg() {
+    consume();
+    return static_cast<const TinyGPSCourse &>(*this).deg();
+  }
+
+  /// Course in degrees without marking it as not updated.
+  /// \return course in degrees
+  double deg() const { return value() / 100.0; }
 };
 
 /// \brief Class to hold GPS altitude value
@@ -372,25 +683,53 @@ struct TinyGPSAltitude : TinyGPSDecimal {
   /// marks data as not updated.
   ///
   /// \return altitude in meters
-  double meters() { return value() / 100.0; }
+  double meters() {
+    consume();
+    return static_cast<const TinyGPSAltitude &>(*this).meters();
+  }
 
   /// Get altitude in miles.
   /// marks data as not updated.
   ///
   /// \return altitude in miles.
-  double miles() { return _GPS_MILES_PER_METER * value() / 100.0; }
+  double miles() {
+    consume();
+    return static_cast<const TinyGPSAltitude &>(*this).miles();
+  }
 
   /// Get altitude in kilometers.
   /// marks data as not updated.
   ///
   /// \return altitude in kilometers
-  double kilometers() { return _GPS_KM_PER_METER * value() / 100.0; }
+  double kilometers() {
+    consume();
+    return static_cast<const TinyGPSAltitude &>(*this).kilometers();
+  }
 
   /// Get altitude in feet.
   /// marks data as not updated.
   ///
   /// \return altitude in feet.
-  double feet() { return _GPS_FEET_PER_METER * value() / 100.0; }
+  double feet() {
+    consume();
+    return static_cast<const TinyGPSAltitude &>(*this).feet();
+  }
+
+  /// Get altitude in meters without marking it as not updated.
+  /// \return altitude in meters
+  double meters() const { return value() / 100.0; }
+
+  /// Get altitude in miles without marking it as not updated.
+  /// \return altitude in miles.
+  double miles() const { return _GPS_MILES_PER_METER * value() / 100.0; }
+
+  /// Get altitude in kilometers without marking it as not updated.
+  /// \return altitude in kilometers
+  double kilometers() const { return _GPS_KM_PER_METER * value() / 100.0; }
+
+  /// Get altitude in feet without marking it as not updated.
+  /// \return altitude in feet.
+  double feet() const { return _GPS_FEET_PER_METER * value() / 100.0; }
 };
 
 /// \brief Class to hold Horizontal dilution of precision (HDOP)
@@ -400,10 +739,245 @@ class TinyGPSHDOP : public TinyGPSDecimal {
 public:
   /// Get the HDOP value and mark as not updated.
   /// \return HDOP value.
-  double hdop() { return value() / 100.0; }
+  double hdop() {
+    consume();
+    return static_cast<const TinyGPSHDOP &>(*this).hdop();
+  }
+
+  /// Get the HDOP value without marking it as not updated.
+  /// \return HDOP value.
+  double hdop() const { return value() / 100.0; }
+};
+
+/// \brief Class to hold Position dilution of precision (PDOP)
+///
+/// This is a GPS Decimal value
+class TinyGPSPDOP : public TinyGPSDecimal {
+public:
+  /// Get the PDOP value and mark as not updated.
+  /// \return PDOP value.
+  double pdop() {
+    consume();
+    return static_cast<const TinyGPSPDOP &>(*this).pdop();
+  }
+
+  /// Get the PDOP value without marking it as not updated.
+  /// \return PDOP value.
+  double pdop() const { return value() / 100.0; }
+};
+
+/// \brief Class to hold Vertical dilution of precision (VDOP)
+///
+/// This is a GPS Decimal value
+class TinyGPSVDOP : public TinyGPSDecimal {
+public:
+  /// Get the VDOP value and mark as not updated.
+  /// \return VDOP value.
+  double vdop() {
+    consume();
+    return static_cast<const TinyGPSVDOP &>(*this).vdop();
+  }
+
+  /// Get the VDOP value without marking it as not updated.
+  /// \return VDOP value.
+  double vdop() const { return value() / 100.0; }
+};
+
+/// \brief Class to hold the pseudorange error statistics sent in GST
+/// sentences
+///
+/// The statistics are kept in thousandths, as receivers often send three
+/// decimals of a meter, and are committed together when the sentence passes
+/// its checksum.
+class TinyGPSErrorStats {
+  friend class TinyGPSPlus;
+
+public:
+  /// The statistics, in GST term order
+  enum Field {
+    RMS,         ///< RMS of the pseudorange residuals
+    SEMI_MAJOR,  ///< standard deviation of the error ellipse semi-major axis
+    SEMI_MINOR,  ///< standard deviation of the error ellipse semi-minor axis
+    ORIENTATION, ///< orientation of the semi-major axis, degrees from true
+                 ///< north
+    LATITUDE,    ///< standard deviation of the latitude error
+    LONGITUDE,   ///< standard deviation of the longitude error
+    ALTITUDE,    ///< standard deviation of the altitude error
+    FIELDS
+  };
+
+  /// Query if the statistics are valid.
+  /// \return true if valid false otherwise.
+  bool isValid() const { return valid; }
+
+  /// Query if the statistics have been updated.
+  /// \return true if updated false otherwise.
+  bool isUpdated() const { return updated; }
+
+  /// Get the age of the statistics in milliseconds
+  /// \return age in milliseconds if valid. ULONG_MAX otherwise.
+  uint32_t age() const {
+    return valid ? TinyGPSClock::now() - lastCommitTime : (uint32_t)ULONG_MAX;
+  }
+
+  /// Get one statistic and mark the statistics as not updated.
+  /// \param field the statistic
+  /// \return millimeters, or thousandths of a degree for ORIENTATION.
+  int32_t value(Field field) {
+    updated = false;
+    return static_cast<const TinyGPSErrorStats &>(*this).value(field);
+  }
+
+  /// Get one statistic without marking the statistics as not updated.
+  /// \param field the statistic
+  /// \return millimeters, or thousandths of a degree for ORIENTATION.
+  int32_t value(Field field) const { return val[field]; }
+
+  /// Mark the statistics as not updated, as the non-const getters do.
+  void consume() { updated = false; }
+
+  /// Get the RMS of the pseudorange residuals and mark the statistics as
+  /// not updated.
+  /// \return RMS in meters
+  double rms() { return value(RMS) / 1000.0; }
+
+  /// Get the standard deviation of the error ellipse semi-major axis and
+  /// mark the statistics as not updated.
+  /// \return standard deviation in meters
+  double semiMajor() { return value(SEMI_MAJOR) / 1000.0; }
+
+  /// Get the standard deviation of the error ellipse semi-minor axis and
+  /// mark the statistics as not updated.
+  /// \return standard deviation in meters
+  double semiMinor() { return value(SEMI_MINOR) / 1000.0; }
+
+  /// Get the orientation of the error ellipse semi-major axis and mark the
+  /// statistics as not updated.
+  /// \return degrees from true north
+  double orientation() { return value(ORIENTATION) / 1000.0; }
+
+  /// Get the standard deviation of the latitude error and mark the
+  /// statistics as not updated.
+  /// \return standard deviation in meters
+  double latitudeError() { return value(LATITUDE) / 1000.0; }
+
+  /// Get the standard deviation of the longitude error and mark the
+  /// statistics as not updated.
+  /// \return standard deviation in meters
+  double longitudeError() { return value(LONGITUDE) / 1000.0; }
+
+  /// Get the standard deviation of the altitude error and mark the
+  /// statistics as not updated.
+  /// \return standard deviation in meters
+  double altitudeError() { return value(ALTITUDE) / 1000.0; }
+
+  /// Get the RMS of the pseudorange residuals without marking the
+  /// statistics as not updated.
+  /// \return RMS in meters
+  double rms() const { return value(RMS) / 1000.0; }
+
+  /// Get the standard deviation of the error ellipse semi-major axis
+  /// without marking the statistics as not updated.
+  /// \return standard deviation in meters
+  double semiMajor() const { return value(SEMI_MAJOR) / 1000.0; }
+
+  /// Get the standard deviation of the error ellipse semi-minor axis
+  /// without marking the statistics as not updated.
+  /// \return standard deviation in meters
+  double semiMinor() const { return value(SEMI_MINOR) / 1000.0; }
+
+  /// Get the orientation of the error ellipse semi-major axis without
+  /// marking the statistics as not updated.
+  /// \return degrees from true north
+  double orientation() const { return value(ORIENTATION) / 1000.0; }
+
+  /// Get the standard deviation of the latitude error without marking the
+  /// statistics as not updated.
+  /// \return standard deviation in meters
+  double latitudeError() const { return value(LATITUDE) / 1000.0; }
+
+  /// Get the standard deviation of the longitude error without marking the
+  /// statistics as not updated.
+  /// \return standard deviation in meters
+  double longitudeError() const { return value(LONGITUDE) / 1000.0; }
+
+  /// Get the standard deviation of the altitude error without marking the
+  /// statistics as not updated.
+  /// \return standard deviation in meters
+  double altitudeError() const { return value(ALTITUDE) / 1000.0; }
+
+  /// Constructor
+  TinyGPSErrorStats()
+      : valid(false), updated(false), lastCommitTime(), val(), newval() {}
+
+private:
+  bool valid, updated;
+  uint32_t lastCommitTime;
+  int32_t val[FIELDS], newval[FIELDS];
+  void commit(uint32_t now);
 };
 
+/// \brief Snapshot of the main fields of a fix, copied as one value
+///
+/// Fields hold the same values as the corresponding TinyGPSPlus objects;
+/// valid and updated are masks of the field bits below. What updated covers
+/// depends on the source: the latest commit for TinyGPSPlus::fix() and
+/// TinyGPSReplay, everything since clearUpdated() for TinyGPSPool. The
+/// struct is trivially copyable and 48 bytes on every target, so a whole
+/// fix can be stored or queued with one copy.
+struct TinyGPSFix {
+  /// Field bits used in valid and updated
+  enum {
+    LOCATION = 1 << 0,
+    DATE = 1 << 1,
+    TIME = 1 << 2,
+    SPEED = 1 << 3,
+    COURSE = 1 << 4,
+    ALTITUDE = 1 << 5,
+    SATELLITES = 1 << 6,
+    HDOP = 1 << 7,
+  };
+
+  int64_t latitude;    ///< billionths of a degree, negative south
+  int64_t longitude;   ///< billionths of a degree, negative west
+  uint32_t date;       ///< ddmmyy
+  uint32_t time;       ///< hhmmsscc
+  int32_t speed;       ///< knots * 100
+  int32_t course;      ///< degrees * 100
+  int32_t altitude;    ///< meters * 100
+  int32_t hdop;        ///< HDOP * 100
+  uint16_t satellites; ///< satellites used, at most 65535
+  uint8_t valid;       ///< fields committed at least once
+  uint8_t updated;     ///< fields committed recently, see above
+  uint32_t commitTime; ///< TinyGPSClock time of the latest commit
+
+  /// Latitude in degrees
+  /// \return the latitude
+  double lat() const { return latitude / 1000000000.0; }
+
+  /// Longitude in degrees
+  /// \return the longitude
+  double lng() const { return longitude / 1000000000.0; }
+};
+
+static_assert(sizeof(TinyGPSFix) == 48, "TinyGPSFix must stay 48 bytes");
+
 class TinyGPSPlus;
+class TinyGPSSatellites;
+
+/// \brief What one validated sentence or UBX frame committed, passed to
+/// commit listeners
+struct TinyGPSCommit {
+  uint8_t sentence; ///< TinyGPSPlus::GPS_SENTENCE_* type of the sentence
+  uint16_t fields;  ///< TinyGPSPlus::COMMIT_* bits of the fields committed
+  uint32_t time;    ///< TinyGPSClock time stamped on those fields
+};
+
+/// \brief Function called after a sentence or frame commits, see
+/// TinyGPSPlus::addListener()
+typedef void (*TinyGPSCommitCallback)(TinyGPSPlus &gps,
+                                      const TinyGPSCommit &commit,
+                                      void *context);
 
 /// \brief Class to allow parsing of custom fields
 class TinyGPSCustom {
@@ -436,47 +1010,146 @@ public:
   /// Get the age of the data in milliseconds
   /// \return age in milliseconds if valid. ULONG_MAX otherwise.
   uint32_t age() const {
-    return valid ? millis() - lastCommitTime : (uint32_t)ULONG_MAX;
+    return valid ? TinyGPSClock::now() - lastCommitTime : (uint32_t)ULONG_MAX;
   }
 
   /// Get the value of the custom data and mark it as not updated.
   /// \return the custom data as a string.
   const char *value() {
     updated = false;
-    return buffer;
+    return static_cast<const TinyGPSCustom &>(*this).value();
   }
 
+  /// Get the value of the custom data without marking it as not updated.
+  /// \return the custom data as a string.
+  const char *value() const { return buffer; }
+
+  /// Mark the data as not updated, as value() does.
+  void consume() { updated = false; }
+
 private:
-  void commit();
+  // Where the value to commit next is: copied into stagingBuffer, viewed in
+  // place in the caller's buffer, or already in buffer
+  enum { STAGED_COPY, STAGED_FIELD, STAGED_COMMITTED };
+
+  void commit(uint32_t now);
   void set(const char *term);
+  void set(const TinyGPSField &term);
 
   char stagingBuffer[_GPS_MAX_FIELD_SIZE + 1];
   char buffer[_GPS_MAX_FIELD_SIZE + 1];
+  TinyGPSField stagedField;
   unsigned long lastCommitTime;
   bool valid, updated;
+  uint8_t staged;
   const char *sentenceName;
+  uint64_t sentenceKey;
   int termNumber;
   friend class TinyGPSPlus;
   TinyGPSCustom *next;
+  TinyGPSCustom *nextSentence;
 };
 
 /// \brief Class to parse NMEA GPS sentences and access the results
+///
+/// The getters of each field, such as location.lat(), mark the field as
+/// not updated, so every read is also a write. Each has a const overload,
+/// used through a const reference, that only reads: several threads can
+/// then read the same parser, once it is no longer parsing, without
+/// writing to its cache lines. consume() marks fields as read explicitly.
 class TinyGPSPlus {
 public:
   /// Constructor
-  TinyGPSPlus();
-
-  /// Process one character received from GPS
+  TinyGPSPlus() : TinyGPSPlus(&_GPS_CONFIG_CHECK) {}
+
+  /// Process one character received from GPS. Unless _GPS_NO_UBX is set,
+  /// as it is by default on Arduino, the stream may mix NMEA sentences with
+  /// u-blox UBX frames: a NAV-PVT frame that passes its checksum updates
+  /// location, date, time, speed, course, altitude, satellites, fixMode and
+  /// pdop, and every frame counts as a sentence in the checksum statistics.
+  /// Likewise unless _GPS_NO_RTCM is set, RTCM3 frames are stepped over
+  /// whole and handed to rtcm. A sentence that fails its checksum is
+  /// discarded whole: none of its terms is committed by a later sentence.
   /// \param c input character
   /// \return true is sentence parsed so far is valid false otherwise.
   bool encode(char c); // process one character received from GPS
 
+  /// Process a buffer of characters received from GPS.
+  /// Equivalent to calling encode(char) for every character, and leaves the
+  /// same state behind, but runs of ordinary characters are copied into the
+  /// current term in one step. Custom fields of a sentence that is complete
+  /// in buffer and passes its checksum are copied once, when committed,
+  /// straight from buffer.
+  /// \param buffer input characters
+  /// \param length number of characters in buffer
+  /// \return number of sentences that passed their checksum in buffer.
+  uint32_t encode(const char *buffer, size_t length);
+
   /// Check to see if any data has been updated.
   ///
   /// \return true if any of location, date, time, speed, course, altitude,
-  /// satellites or hdop have changed, false otherwise.
+  /// satellites, hdop, fixMode, pdop, vdop, timeZone or errorStats have
+  /// changed, false otherwise.
   bool isUpdated() const;
 
+  /// Mark every field checked by isUpdated() as not updated, as reading
+  /// each of them through its non-const getters would.
+  void consume();
+
+  /// Sentence types reported in TinyGPSCommit::sentence
+  enum {
+    GPS_SENTENCE_GGA,
+    GPS_SENTENCE_RMC,
+    GPS_SENTENCE_GSV,
+    GPS_SENTENCE_GSA,
+    GPS_SENTENCE_VTG,
+    GPS_SENTENCE_GLL,
+    GPS_SENTENCE_ZDA,
+    GPS_SENTENCE_GNS,
+    GPS_SENTENCE_GST,
+    GPS_SENTENCE_OTHER, ///< any other sentence, for custom fields
+    GPS_FRAME_UBX       ///< a UBX NAV-PVT frame
+  };
+
+  /// Field bits of TinyGPSCommit::fields. The first eight are the
+  /// TinyGPSFix field bits.
+  enum {
+    COMMIT_LOCATION = TinyGPSFix::LOCATION,
+    COMMIT_DATE = TinyGPSFix::DATE,
+    COMMIT_TIME = TinyGPSFix::TIME,
+    COMMIT_SPEED = TinyGPSFix::SPEED,
+    COMMIT_COURSE = TinyGPSFix::COURSE,
+    COMMIT_ALTITUDE = TinyGPSFix::ALTITUDE,
+    COMMIT_SATELLITES = TinyGPSFix::SATELLITES,
+    COMMIT_HDOP = TinyGPSFix::HDOP,
+    COMMIT_FIX_MODE = 1 << 8,
+    COMMIT_PDOP = 1 << 9,
+    COMMIT_VDOP = 1 << 10,
+    COMMIT_TIME_ZONE = 1 << 11,
+    COMMIT_ERROR_STATS = 1 << 12
+  };
+
+#if _GPS_MAX_LISTENERS > 0
+  /// Register a function to call after each validated sentence or frame
+  /// that commits any of fields, or whose type is in sentences. It runs
+  /// once all the fields of that sentence are committed, so they read as
+  /// one consistent fix, and before encode() returns. The function must not
+  /// call encode(), addListener() or removeListener().
+  /// \param callback the function
+  /// \param context passed to callback
+  /// \param fields COMMIT_* bits to listen for
+  /// \param sentences bits (1 << GPS_SENTENCE_*) of sentence types to
+  /// listen for whatever they commit, for example custom fields
+  /// \return false if _GPS_MAX_LISTENERS are already registered.
+  bool addListener(TinyGPSCommitCallback callback, void *context,
+                   uint16_t fields, uint16_t sentences = 0);
+
+  /// Unregister a function registered with addListener().
+  /// \param callback the function
+  /// \param context the context it was registered with
+  void removeListener(TinyGPSCommitCallback callback, void *context);
+#endif
+
   /// operator version that wraps call to encode
   /// \param c input character
   /// \return TinyGPSPlus reference to this class.
@@ -485,14 +1158,22 @@ public:
     return *this;
   }
 
-  TinyGPSLocation location;  ///< location
-  TinyGPSDate date;          ///< date
-  TinyGPSTime time;          ///< time
-  TinyGPSSpeed speed;        ///< speed
-  TinyGPSCourse course;      ///< course
-  TinyGPSAltitude altitude;  ///< altitude
-  TinyGPSInteger satellites; ///< stellites
-  TinyGPSHDOP hdop;          ///< HDOP
+  TinyGPSLocation location;     ///< location
+  TinyGPSDate date;             ///< date
+  TinyGPSTime time;             ///< time
+  TinyGPSSpeed speed;           ///< speed
+  TinyGPSCourse course;         ///< course
+  TinyGPSAltitude altitude;     ///< altitude
+  TinyGPSInteger satellites;    ///< stellites
+  TinyGPSHDOP hdop;             ///< HDOP, from GGA and GSA
+  TinyGPSInteger fixMode;       ///< GSA fix mode: 1 no fix, 2 2D, 3 3D
+  TinyGPSPDOP pdop;             ///< PDOP, from GSA
+  TinyGPSVDOP vdop;             ///< VDOP, from GSA
+  TinyGPSTimeZone timeZone;     ///< local time zone, from ZDA
+  TinyGPSErrorStats errorStats; ///< pseudorange error statistics, from GST
+#if !_GPS_NO_RTCM
+  TinyGPSRTCM rtcm; ///< RTCM3 frames mixed into the stream
+#endif
 
   /// static Get library version
   /// \return string containing library version
@@ -530,6 +1211,14 @@ public:
   /// "W",  "WNW", "NW", "NNW"
   static const char *cardinal(double course);
 
+  /// Verify the checksum of one NMEA sentence without parsing its fields.
+  /// The XOR of the characters between the optional leading '$' and the
+  /// first '*' is compared against the two hex digits that follow the '*'.
+  /// \param begin first character of the sentence
+  /// \param end one past the last character available
+  /// \return true if the sentence is complete and its checksum matches.
+  static bool verifySentence(const char *begin, const char *end);
+
   static int32_t parseDecimal(const char *term);
   static void parseDegrees(const char *term, RawDegrees &deg);
 
@@ -537,6 +1226,13 @@ public:
   /// \return number of encoded characters
   uint32_t charsProcessed() const { return encodedCharCount; }
 
+  /// Snapshot of location, date, time, speed, course, altitude, satellites
+  /// and hdop as committed by the latest validated sentence or frame. Its
+  /// updated mask holds the fields of the latest commit that changed any of
+  /// them. Reading it does not mark anything as not updated.
+  /// \return the fix
+  TinyGPSFix fix() const { return currentFix; }
+
   /// Number of sentences with a GPS fix.
   /// \return number of GPS fixes
   uint32_t sentencesWithFix() const { return sentencesWithFixCount; }
@@ -550,7 +1246,74 @@ public:
   uint32_t passedChecksum() const { return passedChecksumCount; }
 
 private:
-  enum { GPS_SENTENCE_GPGGA, GPS_SENTENCE_GPRMC, GPS_SENTENCE_OTHER };
+  // Built by the library with its options; the public constructor passes
+  // the _GPS_CONFIG_CHECK symbol of the includer's options, so the two must
+  // match for the program to link
+  explicit TinyGPSPlus(const char *config);
+
+  // What a term holds, looked up in termMap by sentence type and term
+  // number. Shared with TinyGPSPool.
+  enum {
+    TERM_NONE,
+    TERM_TIME,         // hhmmss.ss
+    TERM_DATE,         // ddmmyy
+    TERM_DAY,          // ZDA
+    TERM_MONTH,        // ZDA
+    TERM_YEAR,         // ZDA, four digits
+    TERM_ZONE_HOURS,   // ZDA
+    TERM_ZONE_MINUTES, // ZDA
+    TERM_LATITUDE,
+    TERM_NORTH_SOUTH,
+    TERM_LONGITUDE,
+    TERM_EAST_WEST,
+    TERM_SPEED,        // knots
+    TERM_VTG_SPEED,    // knots, and a fix unless the mode says otherwise
+    TERM_COURSE,
+    TERM_ALTITUDE,
+    TERM_SATELLITES,
+    TERM_HDOP,
+    TERM_PDOP,
+    TERM_VDOP,
+    TERM_FIX_MODE,     // GSA 1-3
+    TERM_ACTIVE,       // GSA PRN or system ID, for TinyGPSSatellites
+    TERM_STATUS,       // 'A' is a fix
+    TERM_QUALITY,      // above '0' is a fix
+    TERM_MODE,         // a fix unless every character is 'N'
+    TERM_ERROR_STATS   // GST, from term 2 on
+  };
+  enum { MAPPED_TERMS = 19 };
+  // termMap and commitMap are in flash on AVR, see _GPS_READ_BYTE
+  static const uint8_t termMap[GPS_SENTENCE_OTHER][MAPPED_TERMS];
+
+  // Fields committed by a sentence type, always and only with a fix
+  struct CommitRule {
+    uint16_t always, withFix;
+  };
+  static const CommitRule commitMap[GPS_SENTENCE_OTHER];
+
+  // What term termNumber of a sentence type holds, TERM_NONE if nothing
+  static uint8_t termKind(uint8_t sentenceType, uint8_t termNumber);
+
+  // Parses a term of a known sentence with the parser its kind needs and
+  // hands the value to sink. The one decoder of TinyGPSPlus and TinyGPSPool,
+  // which differ only in where they stage values: see TermSink in
+  // TinyGPS++.cpp and TinyGPSPool::TermSink.
+  template <typename Sink>
+  static void decodeTerm(uint8_t sentenceType, uint8_t termNumber,
+                         const TinyGPSField &term, Sink &sink);
+  struct TermSink;
+
+  // A ddmmyy date with the day, month or two-digit year replaced, as ZDA
+  // sends them
+  static uint32_t dateWithDay(uint32_t date, uint32_t day) {
+    return date % 10000 + day * 10000;
+  }
+  static uint32_t dateWithMonth(uint32_t date, uint32_t month) {
+    return date / 10000 * 10000 + month % 100 * 100 + date % 100;
+  }
+  static uint32_t dateWithYear(uint32_t date, uint32_t year) {
+    return date / 100 * 100 + year % 100;
+  }
 
   // parsing state variables
   uint8_t parity;
@@ -561,11 +1324,24 @@ private:
   uint8_t curTermOffset;
   bool sentenceHasFix;
 
+  // TinyGPSPool shares the sentence dispatch and checksum helpers
+  friend class TinyGPSPool;
+  friend class TinyGPSPoolConfig;
+  friend class TinyGPSReplay;
+  friend class TinyGPSSentence;
+
   // custom element support
   friend class TinyGPSCustom;
   TinyGPSCustom *customElts;
   TinyGPSCustom *customCandidates;
-  void insertCustom(TinyGPSCustom *pElt, const char *sentenceName, int index);
+  TinyGPSCustom *customCursor;
+  static uint64_t customKey(const char *sentenceName);
+  static int customCompare(const TinyGPSCustom *a, const TinyGPSCustom *b);
+  void insertCustom(TinyGPSCustom *pElt);
+
+  // satellites in view, if a table is attached
+  friend class TinyGPSSatellites;
+  TinyGPSSatellites *satelliteTable;
 
   // statistics
   uint32_t encodedCharCount;
@@ -573,9 +1349,155 @@ private:
   uint32_t failedChecksumCount;
   uint32_t passedChecksumCount;
 
+  // the first eight fields as one value
+  TinyGPSFix currentFix;
+  void updateFix(uint8_t fields, uint32_t now);
+
+#if _GPS_MAX_LISTENERS > 0
+  // commit listeners, called in registration order
+  struct Listener {
+    TinyGPSCommitCallback callback;
+    void *context;
+    uint16_t fields, sentences;
+  };
+  Listener listeners[_GPS_MAX_LISTENERS];
+  uint8_t listenerCount;
+  void notify(uint8_t sentence, uint16_t fields, uint32_t now);
+#endif
+
+#if !_GPS_NO_UBX
+  // binary frames mixed into the stream
+  TinyGPSUBX ubx;
+  bool endOfFrame(uint8_t status);
+  uint16_t commitNavPvt(uint32_t now);
+#endif
+
+#if !_GPS_NO_UBX || !_GPS_NO_RTCM
+  // 0x80 while a UBX or RTCM frame is in progress, 0 otherwise. Frames
+  // start with a character that has its high bit set, which NMEA text never
+  // has, so a text character pays one test: (c | frameFlag) & 0x80.
+  uint8_t frameFlag;
+  enum { FRAME_TEXT, FRAME_BYTE, FRAME_VALID };
+  uint8_t encodeFrame(uint8_t c);
+  const char *encodeFrames(const char *p, const char *end,
+                           uint32_t &validSentences);
+  void updateFrameFlag();
+#endif
+
   // internal utilities
-  int fromHex(char a);
-  bool endOfTermHandler();
+  enum { SENTENCE_INCOMPLETE, SENTENCE_FAILED, SENTENCE_PASSED };
+  static uint8_t checkSentence(const char *begin, const char *end,
+                               const char *&star, const char *&checksumEnd,
+                               uint8_t &sum, bool stopAtBinary = false);
+  static bool checksumMatches(char hi, char lo, uint8_t parity);
+  static bool isFixMode(const TinyGPSField &term);
+  static uint8_t sentenceType(const char *term);
+  const char *encodeText(const char *p, const char *end,
+                         uint32_t &validSentences);
+  void addTermChar(char c) {
+    if (curTermOffset < (sizeof(term) - 1))
+      term[curTermOffset++] = c;
+    if (!isChecksumTerm)
+      parity ^= c;
+  }
+  void beginSentence();
+  void discardSentence();
+  bool endOfTerm(char c, const TinyGPSField *inPlace = NULL);
+  bool endOfTermHandler(const TinyGPSField *inPlace);
 };
 
+template <typename Sink>
+void TinyGPSPlus::decodeTerm(uint8_t sentenceType, uint8_t termNumber,
+                             const TinyGPSField &term, Sink &sink) {
+  if (term.empty())
+    return;
+  switch (termKind(sentenceType, termNumber)) {
+  case TERM_TIME:
+    sink.time((uint32_t)term.toDecimal());
+    break;
+  case TERM_DATE:
+    sink.date(term.toUnsigned());
+    break;
+  case TERM_DAY:
+    sink.day(term.toUnsigned());
+    break;
+  case TERM_MONTH:
+    sink.month(term.toUnsigned());
+    break;
+  case TERM_YEAR:
+    sink.year(term.toUnsigned());
+    break;
+  case TERM_ZONE_HOURS: {
+    // The sign is kept apart from the hours, so that -00 is negative
+    bool negative = term[0] == '-';
+    uint32_t hours = term.toUnsigned();
+    sink.zoneHours(negative, (uint8_t)(negative ? 0 - hours : hours));
+    break;
+  }
+  case TERM_ZONE_MINUTES:
+    sink.zoneMinutes((uint8_t)term.toUnsigned());
+    break;
+  case TERM_LATITUDE: {
+    RawDegrees deg;
+    term.toDegrees(deg);
+    sink.latitude(deg);
+    break;
+  }
+  case TERM_NORTH_SOUTH:
+    sink.south(term[0] == 'S');
+    break;
+  case TERM_LONGITUDE: {
+    RawDegrees deg;
+    term.toDegrees(deg);
+    sink.longitude(deg);
+    break;
+  }
+  case TERM_EAST_WEST:
+    sink.west(term[0] == 'W');
+    break;
+  case TERM_VTG_SPEED:
+    sink.hasFix(true);
+    // Fallthrough
+  case TERM_SPEED:
+    sink.speed(term.toDecimal());
+    break;
+  case TERM_COURSE:
+    sink.course(term.toDecimal());
+    break;
+  case TERM_ALTITUDE:
+    sink.altitude(term.toDecimal());
+    break;
+  case TERM_SATELLITES:
+    sink.satellites(term.toUnsigned());
+    break;
+  case TERM_HDOP:
+    sink.hdop(term.toDecimal());
+    break;
+  case TERM_PDOP:
+    sink.pdop(term.toDecimal());
+    break;
+  case TERM_VDOP:
+    sink.vdop(term.toDecimal());
+    break;
+  case TERM_FIX_MODE:
+    sink.fixMode(term.toUnsigned());
+    break;
+  case TERM_ACTIVE:
+    sink.active(termNumber);
+    break;
+  case TERM_STATUS:
+    sink.hasFix(term[0] == 'A');
+    break;
+  case TERM_QUALITY:
+    sink.hasFix(term[0] > '0');
+    break;
+  case TERM_MODE:
+    sink.hasFix(isFixMode(term));
+    break;
+  case TERM_ERROR_STATS:
+    sink.errorStat((uint8_t)(termNumber - 2), term.toThousandths());
+    break;
+  }
+}
+
 #endif // def(__TinyGPSPlus_h)
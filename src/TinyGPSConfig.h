@@ -0,0 +1,123 @@
+/*
+TinyGPS++ - a small GPS library for Arduino providing universal NMEA parsing
+Copyright (C) 2008-2013 Mikal Hart
+All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef __TinyGPSConfig_h
+#define __TinyGPSConfig_h
+
+/// \file
+/// \brief Build options of TinyGPS++.
+///
+/// Most options change the size of TinyGPSPlus or the classes it holds, so
+/// the sketch and the library sources must see the same values. On Arduino
+/// the library is compiled separately from the sketch, so a macro defined in
+/// the sketch before including TinyGPS++.h does not reach it: change the
+/// defaults below instead, or pass the options to the whole build, as the
+/// -D flags of a host build do. A mismatch fails at link time with an
+/// undefined reference to a _GPS_CONFIG_CHECK symbol naming the options.
+
+#ifndef ARDUINO
+#define _GPS_HOST_BUILD ///< building for a host OS instead of an Arduino core
+#endif
+
+#ifndef _GPS_MAX_LISTENERS
+/// Commit listeners per parser, 0 to leave them out
+#define _GPS_MAX_LISTENERS 4
+#endif
+
+#ifndef _GPS_NO_UBX
+#ifdef _GPS_HOST_BUILD
+#define _GPS_NO_UBX 0
+#else
+/// Set to 0 to decode UBX frames mixed into the NMEA stream, 1 to parse
+/// NMEA only. Hosts decode them by default.
+#define _GPS_NO_UBX 1
+#endif
+#endif
+
+#ifndef _GPS_UBX_MAX_PAYLOAD
+/// Longest UBX payload accepted. A longer length is taken as a false sync
+/// and the frame is dropped.
+#define _GPS_UBX_MAX_PAYLOAD 2048
+#endif
+
+#ifndef _GPS_NO_RTCM
+#ifdef _GPS_HOST_BUILD
+#define _GPS_NO_RTCM 0
+#else
+/// Set to 0 to step over RTCM3 frames mixed into the NMEA stream, 1 to
+/// leave RTCM3 framing out. Hosts step over them by default.
+#define _GPS_NO_RTCM 1
+#endif
+#endif
+
+#ifndef _GPS_RTCM_MAX_TYPES
+/// Number of distinct message types counted by TinyGPSRTCM
+#define _GPS_RTCM_MAX_TYPES 16
+#endif
+
+#ifndef _GPS_RTCM_REASSEMBLY
+#ifdef _GPS_HOST_BUILD
+#define _GPS_RTCM_REASSEMBLY 1
+#else
+/// Set to 1 to copy frames fed a character at a time into a 1029 byte
+/// buffer, so they can be forwarded too. Hosts do by default.
+#define _GPS_RTCM_REASSEMBLY 0
+#endif
+#endif
+
+#ifndef _GPS_MAX_SATELLITES
+/// Capacity of the TinyGPSSatellites table. Satellites beyond it are dropped.
+#define _GPS_MAX_SATELLITES 32
+#endif
+
+#ifndef _GPS_MAX_SENTENCE_TERMS
+/// Maximum number of terms, address included, kept by TinyGPSSentence
+#define _GPS_MAX_SENTENCE_TERMS 32
+#endif
+
+static_assert(_GPS_MAX_LISTENERS >= 0 && _GPS_MAX_LISTENERS <= 255,
+              "_GPS_MAX_LISTENERS must be 0 to 255");
+static_assert(_GPS_NO_UBX == 0 || _GPS_NO_UBX == 1,
+              "_GPS_NO_UBX must be 0 or 1");
+static_assert(_GPS_NO_RTCM == 0 || _GPS_NO_RTCM == 1,
+              "_GPS_NO_RTCM must be 0 or 1");
+static_assert(_GPS_RTCM_REASSEMBLY == 0 || _GPS_RTCM_REASSEMBLY == 1,
+              "_GPS_RTCM_REASSEMBLY must be 0 or 1");
+static_assert(_GPS_RTCM_MAX_TYPES > 0 && _GPS_MAX_SATELLITES > 0 &&
+                  _GPS_MAX_SATELLITES <= 255 && _GPS_MAX_SENTENCE_TERMS > 0,
+              "table sizes must be positive");
+
+#define _GPS_CONFIG_NAME(l, u, r, a, t, s, n)                                  \
+  TinyGPS_config_listeners##l##_noUbx##u##_noRtcm##r##_reassembly##a           \
+      ##_types##t##_satellites##s##_terms##n
+#define _GPS_CONFIG_EXPAND(l, u, r, a, t, s, n)                                \
+  _GPS_CONFIG_NAME(l, u, r, a, t, s, n)
+
+/// Symbol defined by the library with the options it was built with, and
+/// referenced by every TinyGPSPlus constructed with the options of the
+/// including source file
+#define _GPS_CONFIG_CHECK                                                      \
+  _GPS_CONFIG_EXPAND(_GPS_MAX_LISTENERS, _GPS_NO_UBX, _GPS_NO_RTCM,            \
+                     _GPS_RTCM_REASSEMBLY, _GPS_RTCM_MAX_TYPES,                \
+                     _GPS_MAX_SATELLITES, _GPS_MAX_SENTENCE_TERMS)
+
+extern const char _GPS_CONFIG_CHECK;
+
+#endif
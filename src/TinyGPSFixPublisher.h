@@ -0,0 +1,154 @@
+/*
+TinyGPS++ - a small GPS library for Arduino providing universal NMEA parsing
+Copyright (C) 2008-2013 Mikal Hart
+All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef __TinyGPSFixPublisher_h
+#define __TinyGPSFixPublisher_h
+
+/// \file
+/// \brief Lock-free publication of the latest fix to reader threads (host
+/// builds only).
+///
+/// The fields of a TinyGPSPlus are plain members, and even their accessors
+/// write to them, so no other thread may read them while the parser runs.
+/// TinyGPSFixPublisher holds a copy of the latest TinyGPSFix behind a
+/// sequence lock instead: the parsing thread publishes each fix once, and
+/// any number of reader threads load it without locks and without seeing
+/// half of one fix and half of another.
+
+#include "TinyGPS++.h"
+
+#ifdef _GPS_HOST_BUILD
+
+#include <atomic>
+#include <string.h>
+
+/// \brief Latest TinyGPSFix, written by one thread and read by many
+///
+/// A sequence lock: the writer makes the sequence number odd, stores the
+/// fix and makes it even again; a reader copies the fix between two reads
+/// of the sequence number and retries if a write overlapped. Loads never
+/// block the writer and only retry while a publish is in progress. The fix
+/// is held in atomic words, so the copy is free of data races. Each word is
+/// stored with release and loaded with acquire, rather than fenced: a
+/// reader that sees any word of a new fix then sees the odd sequence number
+/// written before it, and these orders are plain moves on x86.
+class TinyGPSFixPublisher {
+public:
+  /// Constructor. Until the first publish, load() returns an all-zero fix.
+  TinyGPSFixPublisher() : sequence(0) {
+    for (size_t i = 0; i < WORDS; ++i)
+      words[i].store(0, std::memory_order_relaxed);
+#if _GPS_MAX_LISTENERS > 0
+    parser = NULL;
+#endif
+  }
+
+#if _GPS_MAX_LISTENERS > 0
+  ~TinyGPSFixPublisher() { detach(); }
+#endif
+
+  TinyGPSFixPublisher(const TinyGPSFixPublisher &) = delete;
+  TinyGPSFixPublisher &operator=(const TinyGPSFixPublisher &) = delete;
+
+  /// Publish a fix. Only one thread at a time may publish.
+  /// \param fix the fix
+  void publish(const TinyGPSFix &fix) {
+    uint64_t copy[WORDS];
+    memcpy(copy, &fix, sizeof(copy));
+    uint32_t s = sequence.load(std::memory_order_relaxed);
+    sequence.store(s + 1, std::memory_order_relaxed);
+    for (size_t i = 0; i < WORDS; ++i)
+      words[i].store(copy[i], std::memory_order_release);
+    sequence.store(s + 2, std::memory_order_release);
+  }
+
+  /// Load the latest published fix. Safe from any number of threads.
+  /// \param fix set to the fix
+  /// \return the number of fixes published before it, which changes
+  /// whenever a new fix is loaded.
+  uint32_t load(TinyGPSFix &fix) const {
+    uint64_t copy[WORDS];
+    uint32_t before, after;
+    do {
+      before = sequence.load(std::memory_order_acquire);
+      for (size_t i = 0; i < WORDS; ++i)
+        copy[i] = words[i].load(std::memory_order_acquire);
+      after = sequence.load(std::memory_order_relaxed);
+    } while ((before & 1) || before != after);
+    memcpy(&fix, copy, sizeof(fix));
+    return before / 2;
+  }
+
+  /// Load the latest published fix.
+  /// \return the fix
+  TinyGPSFix load() const {
+    TinyGPSFix fix;
+    load(fix);
+    return fix;
+  }
+
+  /// Number of fixes published so far. Compare with a previous value to
+  /// see if load() would return a new fix.
+  /// \return publish count
+  uint32_t version() const {
+    return sequence.load(std::memory_order_acquire) / 2;
+  }
+
+#if _GPS_MAX_LISTENERS > 0
+  /// Publish gps.fix() after every sentence that commits one of its
+  /// fields, from inside gps.encode(). Uses one listener of gps.
+  /// \param gps the parser, which must not be destroyed while attached
+  /// \return false if gps has no free listener.
+  bool attach(TinyGPSPlus &gps) {
+    detach();
+    if (!gps.addListener(onCommit, this, 0xFF))
+      return false;
+    parser = &gps;
+    return true;
+  }
+
+  /// Stop publishing the fixes of the attached parser, if any.
+  void detach() {
+    if (parser != NULL)
+      parser->removeListener(onCommit, this);
+    parser = NULL;
+  }
+#endif
+
+private:
+  enum { WORDS = sizeof(TinyGPSFix) / sizeof(uint64_t) };
+  static_assert(sizeof(TinyGPSFix) % sizeof(uint64_t) == 0,
+                "TinyGPSFix must be a whole number of words");
+
+  // The sequence number and the fix share one cache line of their own
+  alignas(64) std::atomic<uint32_t> sequence;
+  std::atomic<uint64_t> words[WORDS];
+
+#if _GPS_MAX_LISTENERS > 0
+  TinyGPSPlus *parser;
+  static void onCommit(TinyGPSPlus &gps, const TinyGPSCommit &, void *self) {
+    ((TinyGPSFixPublisher *)self)->publish(gps.fix());
+  }
+#endif
+};
+
+#endif // _GPS_HOST_BUILD
+
+#endif // def(__TinyGPSFixPublisher_h)
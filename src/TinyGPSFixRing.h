@@ -0,0 +1,242 @@
+/*
+TinyGPS++ - a small GPS library for Arduino providing universal NMEA parsing
+Copyright (C) 2008-2013 Mikal Hart
+All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef __TinyGPSFixRing_h
+#define __TinyGPSFixRing_h
+
+/// \file
+/// \brief Lock-free queue of fixes from the parsing thread to one consumer
+/// thread (host builds only).
+///
+/// Where TinyGPSFixPublisher keeps only the latest fix for any number of
+/// readers, TinyGPSFixRing keeps every fix for a single consumer, such as a
+/// storage or geofencing stage, which drains them in batches.
+
+#include "TinyGPS++.h"
+
+#ifdef _GPS_HOST_BUILD
+
+#include <atomic>
+#include <string.h>
+#include <thread>
+
+/// \brief Bounded single-producer, single-consumer queue of TinyGPSFix
+///
+/// Holds up to N fixes, N a power of two. One thread pushes, usually from a
+/// commit listener set up by attach(), and one thread pops. The head and
+/// tail counters sit on cache lines of their own, each next to the other
+/// side's counter as last seen, so neither thread reads the other's line
+/// until its cached copy says the queue is full or empty.
+///
+/// \tparam N capacity in fixes, a power of two
+template <size_t N> class TinyGPSFixRing {
+  static_assert(N >= 2 && (N & (N - 1)) == 0,
+                "TinyGPSFixRing capacity must be a power of two");
+
+public:
+  /// What push() does when the queue is full
+  enum Policy {
+    BLOCK,      ///< wait for the consumer, holding up the producer
+    DROP_OLDEST ///< discard the oldest queued fix to make room
+  };
+
+  /// Sentence types attach() queues a fix for by default: GGA, RMC, GNS
+  /// and UBX NAV-PVT
+  static const uint16_t FIX_SENTENCES =
+      (1 << TinyGPSPlus::GPS_SENTENCE_GGA) |
+      (1 << TinyGPSPlus::GPS_SENTENCE_RMC) |
+      (1 << TinyGPSPlus::GPS_SENTENCE_GNS) | (1 << TinyGPSPlus::GPS_FRAME_UBX);
+
+  /// Constructor
+  /// \param _policy what push() does when the queue is full
+  explicit TinyGPSFixRing(Policy _policy = BLOCK)
+      : policy(_policy), head(0), cachedTail(0), droppedCount(0), tail(0),
+        cachedHead(0) {
+#if _GPS_MAX_LISTENERS > 0
+    parser = NULL;
+#endif
+  }
+
+#if _GPS_MAX_LISTENERS > 0
+  ~TinyGPSFixRing() { detach(); }
+#endif
+
+  TinyGPSFixRing(const TinyGPSFixRing &) = delete;
+  TinyGPSFixRing &operator=(const TinyGPSFixRing &) = delete;
+
+  /// Capacity
+  /// \return N
+  static size_t capacity() { return N; }
+
+  /// Queue a fix, following the policy if the queue is full. Producer only.
+  /// \param fix the fix
+  void push(const TinyGPSFix &fix) {
+    uint64_t h = head.load(std::memory_order_relaxed);
+    while (h - cachedTail >= N) {
+      cachedTail = tail.load(std::memory_order_acquire);
+      if (h - cachedTail < N)
+        break;
+      if (policy == DROP_OLDEST) {
+        if (tail.compare_exchange_weak(cachedTail, cachedTail + 1,
+                                       std::memory_order_acq_rel)) {
+          ++cachedTail;
+          droppedCount.fetch_add(1, std::memory_order_relaxed);
+        }
+      } else {
+        std::this_thread::yield();
+      }
+    }
+    store(h, fix);
+    head.store(h + 1, std::memory_order_release);
+  }
+
+  /// Queue a fix unless the queue is full, whatever the policy. Producer
+  /// only.
+  /// \param fix the fix
+  /// \return false if the queue was full and fix was not queued.
+  bool tryPush(const TinyGPSFix &fix) {
+    uint64_t h = head.load(std::memory_order_relaxed);
+    if (h - cachedTail >= N) {
+      cachedTail = tail.load(std::memory_order_acquire);
+      if (h - cachedTail >= N)
+        return false;
+    }
+    store(h, fix);
+    head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Dequeue up to max fixes, oldest first. Consumer only.
+  /// \param fixes destination for the fixes
+  /// \param max room in fixes
+  /// \return number of fixes dequeued, 0 if the queue is empty.
+  size_t pop(TinyGPSFix *fixes, size_t max) {
+    for (;;) {
+      uint64_t t = tail.load(std::memory_order_acquire);
+      // Signed, as the DROP_OLDEST producer may move the tail past the
+      // cached head
+      if ((int64_t)(cachedHead - t) < (int64_t)max)
+        cachedHead = head.load(std::memory_order_acquire);
+      size_t count = (size_t)(cachedHead - t) < max ? (size_t)(cachedHead - t)
+                                                      : max;
+      if (count == 0)
+        return 0;
+      for (size_t i = 0; i < count; ++i)
+        load(t + i, fixes[i]);
+      // With DROP_OLDEST the producer may have moved the tail past fixes
+      // it then overwrote; the copies are thrown away and taken again
+      if (policy != DROP_OLDEST) {
+        tail.store(t + count, std::memory_order_release);
+        return count;
+      }
+      if (tail.compare_exchange_strong(t, t + count,
+                                       std::memory_order_acq_rel))
+        return count;
+    }
+  }
+
+  /// Dequeue the oldest fix. Consumer only.
+  /// \param fix set to the fix
+  /// \return false if the queue is empty.
+  bool pop(TinyGPSFix &fix) { return pop(&fix, 1) == 1; }
+
+  /// Number of fixes queued, which may change as soon as it is read
+  /// \return fix count
+  size_t size() const {
+    return (size_t)(head.load(std::memory_order_acquire) -
+                    tail.load(std::memory_order_acquire));
+  }
+
+  /// Number of fixes discarded by the DROP_OLDEST policy
+  /// \return count of dropped fixes
+  uint64_t dropped() const {
+    return droppedCount.load(std::memory_order_relaxed);
+  }
+
+#if _GPS_MAX_LISTENERS > 0
+  /// Push gps.fix() after every validated sentence of the given types,
+  /// from inside gps.encode(). Uses one listener of gps.
+  /// \param gps the parser, which must not be destroyed while attached
+  /// \param sentences bits (1 << TinyGPSPlus::GPS_SENTENCE_*) of the
+  /// sentence types to queue a fix for
+  /// \return false if gps has no free listener.
+  bool attach(TinyGPSPlus &gps, uint16_t sentences = FIX_SENTENCES) {
+    detach();
+    if (!gps.addListener(onCommit, this, 0, sentences))
+      return false;
+    parser = &gps;
+    return true;
+  }
+
+  /// Stop queueing the fixes of the attached parser, if any.
+  void detach() {
+    if (parser != NULL)
+      parser->removeListener(onCommit, this);
+    parser = NULL;
+  }
+#endif
+
+private:
+  enum { WORDS = sizeof(TinyGPSFix) / sizeof(uint64_t) };
+
+  const Policy policy;
+
+  // Producer side
+  alignas(64) std::atomic<uint64_t> head;
+  uint64_t cachedTail;
+  std::atomic<uint64_t> droppedCount;
+
+  // Consumer side
+  alignas(64) std::atomic<uint64_t> tail;
+  uint64_t cachedHead;
+
+  // Fixes as words, so that a slot the DROP_OLDEST producer overwrites
+  // while the consumer copies it is not a data race
+  alignas(64) std::atomic<uint64_t> slots[N][WORDS];
+
+#if _GPS_MAX_LISTENERS > 0
+  TinyGPSPlus *parser;
+  static void onCommit(TinyGPSPlus &gps, const TinyGPSCommit &, void *self) {
+    ((TinyGPSFixRing *)self)->push(gps.fix());
+  }
+#endif
+
+  void store(uint64_t index, const TinyGPSFix &fix) {
+    uint64_t copy[WORDS];
+    memcpy(copy, &fix, sizeof(copy));
+    std::atomic<uint64_t> *slot = slots[index & (N - 1)];
+    for (size_t i = 0; i < WORDS; ++i)
+      slot[i].store(copy[i], std::memory_order_relaxed);
+  }
+
+  void load(uint64_t index, TinyGPSFix &fix) const {
+    uint64_t copy[WORDS];
+    const std::atomic<uint64_t> *slot = slots[index & (N - 1)];
+    for (size_t i = 0; i < WORDS; ++i)
+      copy[i] = slot[i].load(std::memory_order_relaxed);
+    memcpy(&fix, copy, sizeof(fix));
+  }
+};
+
+template <size_t N> const uint16_t TinyGPSFixRing<N>::FIX_SENTENCES;
+
+#endif // _GPS_HOST_BUILD
+
+#endif // def(__TinyGPSFixRing_h)
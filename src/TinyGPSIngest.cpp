@@ -0,0 +1,167 @@
+/*
+TinyGPS++ - a small GPS library for Arduino providing universal NMEA parsing
+Copyright (C) 2008-2013 Mikal Hart
+All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "TinyGPSIngest.h"
+
+#ifdef _GPS_HOST_BUILD
+
+/// \file
+/// \brief TinyGPSIngest implementation file
+
+TinyGPSIngest::TinyGPSIngest(TinyGPSPool &_pool, unsigned workerCount)
+    : pool(_pool), queues(new StreamQueue[_pool.size()]), queuedTasks(0),
+      pendingChunks(0), stopping(false) {
+  if (workerCount == 0)
+    workerCount = 1;
+  for (unsigned i = 0; i < workerCount; ++i)
+    workerList.emplace_back(new Worker);
+  for (unsigned i = 0; i < workerCount; ++i)
+    workerList[i]->thread = std::thread(&TinyGPSIngest::workerLoop, this, i);
+}
+
+TinyGPSIngest::~TinyGPSIngest() {
+  {
+    std::lock_guard<std::mutex> guard(idleLock);
+    stopping = true;
+  }
+  wake.notify_all();
+  for (size_t i = 0; i < workerList.size(); ++i)
+    workerList[i]->thread.join();
+}
+
+void TinyGPSIngest::submit(size_t stream, std::string &&chunk) {
+  pendingChunks.fetch_add(1);
+
+  StreamQueue &queue = queues[stream];
+  bool idle;
+  {
+    std::lock_guard<std::mutex> guard(queue.lock);
+    queue.pending.push_back(std::move(chunk));
+    idle = !queue.scheduled;
+    queue.scheduled = true;
+  }
+
+  // A stream that is queued or running already will pick the chunk up
+  if (idle)
+    schedule((unsigned)(stream % workerList.size()), stream);
+}
+
+void TinyGPSIngest::drain() {
+  std::unique_lock<std::mutex> guard(drainLock);
+  drained.wait(guard, [this] { return pendingChunks.load() == 0; });
+}
+
+uint64_t TinyGPSIngest::sentences() const {
+  uint64_t total = 0;
+  for (size_t i = 0; i < workerList.size(); ++i)
+    total += workerList[i]->sentences.load(std::memory_order_relaxed);
+  return total;
+}
+
+uint64_t TinyGPSIngest::steals() const {
+  uint64_t total = 0;
+  for (size_t i = 0; i < workerList.size(); ++i)
+    total += workerList[i]->steals.load(std::memory_order_relaxed);
+  return total;
+}
+
+// Puts a stream task on the back of a worker's deque and wakes a worker
+void TinyGPSIngest::schedule(unsigned worker, size_t stream) {
+  queuedTasks.fetch_add(1);
+  {
+    std::lock_guard<std::mutex> guard(workerList[worker]->lock);
+    workerList[worker]->tasks.push_back(stream);
+  }
+  // Taking the lock orders this against a worker about to sleep
+  { std::lock_guard<std::mutex> guard(idleLock); }
+  wake.notify_one();
+}
+
+// Takes the next task from the front of the worker's own deque, or steals
+// one from the back of another worker's
+bool TinyGPSIngest::take(unsigned worker, size_t &stream) {
+  size_t count = workerList.size();
+  for (size_t i = 0; i < count; ++i) {
+    Worker &victim = *workerList[(worker + i) % count];
+    std::lock_guard<std::mutex> guard(victim.lock);
+    if (victim.tasks.empty())
+      continue;
+    if (i == 0) {
+      stream = victim.tasks.front();
+      victim.tasks.pop_front();
+    } else {
+      stream = victim.tasks.back();
+      victim.tasks.pop_back();
+      workerList[worker]->steals.fetch_add(1, std::memory_order_relaxed);
+    }
+    queuedTasks.fetch_sub(1);
+    return true;
+  }
+  return false;
+}
+
+// Parses the chunks a stream has queued. The stream stays scheduled while
+// it runs, so no other worker can pick it up; if more chunks arrived in the
+// meantime it goes back on this worker's deque behind the other tasks.
+void TinyGPSIngest::run(unsigned worker, size_t stream) {
+  StreamQueue &queue = queues[stream];
+  std::vector<std::string> batch;
+  {
+    std::lock_guard<std::mutex> guard(queue.lock);
+    batch.swap(queue.pending);
+  }
+
+  uint64_t sentences = 0;
+  for (size_t i = 0; i < batch.size(); ++i)
+    sentences += pool.feed(stream, batch[i].data(), batch[i].size());
+  workerList[worker]->sentences.fetch_add(sentences,
+                                          std::memory_order_relaxed);
+
+  bool more;
+  {
+    std::lock_guard<std::mutex> guard(queue.lock);
+    more = !queue.pending.empty();
+    queue.scheduled = more;
+  }
+  if (more)
+    schedule(worker, stream);
+
+  if (pendingChunks.fetch_sub(batch.size()) == batch.size()) {
+    std::lock_guard<std::mutex> guard(drainLock);
+    drained.notify_all();
+  }
+}
+
+void TinyGPSIngest::workerLoop(unsigned worker) {
+  for (;;) {
+    size_t stream;
+    if (take(worker, stream)) {
+      run(worker, stream);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> guard(idleLock);
+    wake.wait(guard, [this] { return queuedTasks.load() > 0 || stopping; });
+    if (stopping && queuedTasks.load() == 0)
+      return;
+  }
+}
+
+#endif // _GPS_HOST_BUILD
@@ -0,0 +1,130 @@
+/*
+TinyGPS++ - a small GPS library for Arduino providing universal NMEA parsing
+Copyright (C) 2008-2013 Mikal Hart
+All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef __TinyGPSIngest_h
+#define __TinyGPSIngest_h
+
+/// \file
+/// \brief Multi-threaded ingest of many receiver streams into a TinyGPSPool
+/// (host builds only).
+///
+/// A fixed set of worker threads parses the streams of a TinyGPSPool. A
+/// stream with queued chunks is a task that sits in exactly one worker's
+/// deque, or is being run by exactly one worker, so the chunks of a stream
+/// are always parsed in submission order. Workers take tasks from the front
+/// of their own deque; an idle worker steals from the back of another's.
+
+#include "TinyGPSPool.h"
+
+#ifdef _GPS_HOST_BUILD
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// \brief Work-stealing parser thread pool for TinyGPSPool streams
+///
+/// Sentences are committed on the worker threads, so TinyGPSClock::hold()
+/// on the submitting thread does not apply to them. Read fixes from the
+/// pool after drain().
+class TinyGPSIngest {
+public:
+  /// Constructor. Starts the worker threads.
+  /// \param pool the streams to parse into, which must outlive this object
+  /// \param workerCount number of worker threads, at least 1
+  TinyGPSIngest(TinyGPSPool &pool, unsigned workerCount);
+
+  /// Destructor. Finishes every submitted chunk, then stops the workers.
+  ~TinyGPSIngest();
+
+  /// Queue a chunk of characters received on one stream. The characters
+  /// are copied. May be called from any thread.
+  /// \param stream stream number in the pool
+  /// \param buffer input characters
+  /// \param length number of characters in buffer
+  void submit(size_t stream, const char *buffer, size_t length) {
+    submit(stream, std::string(buffer, length));
+  }
+
+  /// Queue a chunk of characters received on one stream, taking ownership
+  /// of it.
+  /// \param stream stream number in the pool
+  /// \param chunk input characters
+  void submit(size_t stream, std::string &&chunk);
+
+  /// Block until every chunk submitted so far has been parsed.
+  void drain();
+
+  /// Number of worker threads
+  /// \return worker count
+  unsigned workers() const { return (unsigned)workerList.size(); }
+
+  /// Number of parsed sentences that passed their checksum
+  /// \return count of sentences, summed over all workers
+  uint64_t sentences() const;
+
+  /// Number of tasks a worker took from another worker's deque
+  /// \return count of steals, summed over all workers
+  uint64_t steals() const;
+
+private:
+  // Chunks of one stream not yet handed to a worker
+  struct StreamQueue {
+    std::mutex lock;
+    std::vector<std::string> pending;
+    bool scheduled;
+    StreamQueue() : scheduled(false) {}
+  };
+
+  struct alignas(64) Worker {
+    std::mutex lock;
+    std::deque<size_t> tasks;
+    std::thread thread;
+    std::atomic<uint64_t> sentences;
+    std::atomic<uint64_t> steals;
+    Worker() : sentences(0), steals(0) {}
+  };
+
+  TinyGPSPool &pool;
+  std::unique_ptr<StreamQueue[]> queues;
+  std::vector<std::unique_ptr<Worker>> workerList;
+
+  std::atomic<size_t> queuedTasks;
+  std::atomic<size_t> pendingChunks;
+  bool stopping;
+  std::mutex idleLock;
+  std::condition_variable wake;
+  std::mutex drainLock;
+  std::condition_variable drained;
+
+  void schedule(unsigned worker, size_t stream);
+  bool take(unsigned worker, size_t &stream);
+  void run(unsigned worker, size_t stream);
+  void workerLoop(unsigned worker);
+};
+
+#endif // _GPS_HOST_BUILD
+
+#endif // def(__TinyGPSIngest_h)
@@ -0,0 +1,114 @@
+/*
+TinyGPS++ - a small GPS library for Arduino providing universal NMEA parsing
+Copyright (C) 2008-2013 Mikal Hart
+All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "TinyGPSLogReader.h"
+
+#ifdef _GPS_HOST_BUILD
+
+#include "TinyGPSScanner.h"
+
+/// \file
+/// \brief TinyGPSLogReader implementation file
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+bool TinyGPSLogReader::open(const char *path) {
+  close();
+
+  int fd = ::open(path, O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    ::close(fd);
+    return false;
+  }
+
+  length = (size_t)st.st_size;
+  if (length > 0) {
+    void *m = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (m == MAP_FAILED) {
+      ::close(fd);
+      length = 0;
+      return false;
+    }
+    mapping = m;
+    madvise(mapping, length, MADV_SEQUENTIAL);
+#ifdef MADV_HUGEPAGE
+    // Only a hint: most kernels ignore it for file mappings
+    madvise(mapping, length, MADV_HUGEPAGE);
+#endif
+  }
+  ::close(fd);
+  cursor = 0;
+  opened = true;
+  return true;
+}
+
+void TinyGPSLogReader::close() {
+  if (mapping != NULL)
+    munmap(mapping, length);
+  mapping = NULL;
+  length = 0;
+  cursor = 0;
+  opened = false;
+}
+
+uint64_t TinyGPSLogReader::encodeInto(TinyGPSPlus &gps,
+                                      size_t sliceSize) const {
+  if (sliceSize == 0)
+    sliceSize = length;
+  uint64_t sentences = 0;
+  for (size_t offset = 0; offset < length; offset += sliceSize) {
+    size_t n = length - offset < sliceSize ? length - offset : sliceSize;
+    sentences += gps.encode(data() + offset, n);
+  }
+  return sentences;
+}
+
+bool TinyGPSLogReader::nextSentence(const char *&begin, const char *&end) {
+  if (cursor >= length)
+    return false;
+
+  const char *base = data();
+  const char *last = base + length;
+  const char *p = (const char *)memchr(base + cursor, '$', length - cursor);
+  if (p == NULL) {
+    cursor = length;
+    return false;
+  }
+
+  // The sentence runs to the line ending or the next '$'; the scanner also
+  // stops at the '*' before the checksum, so step over it
+  uint8_t ignored = 0;
+  const char *q = TinyGPSScanner::findSentenceEnd(p + 1, last, ignored);
+  while (q < last && *q == '*')
+    q = TinyGPSScanner::findSentenceEnd(q + 1, last, ignored);
+
+  begin = p;
+  end = q;
+  cursor = q - base;
+  return true;
+}
+
+#endif // _GPS_HOST_BUILD
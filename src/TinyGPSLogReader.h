@@ -0,0 +1,131 @@
+/*
+TinyGPS++ - a small GPS library for Arduino providing universal NMEA parsing
+Copyright (C) 2008-2013 Mikal Hart
+All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef __TinyGPSLogReader_h
+#define __TinyGPSLogReader_h
+
+/// \file
+/// \brief Memory-mapped reader for recorded NMEA logs (host builds only).
+///
+/// The whole log is mapped read-only and handed to the parser in place: no
+/// read() buffers, no per-byte getc(). The mapping is advised as sequential,
+/// so the kernel reads ahead and drops pages behind the parser, and as a
+/// huge-page candidate where the kernel supports that for file mappings.
+
+#include "TinyGPSSentence.h"
+
+#ifdef _GPS_HOST_BUILD
+
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+
+/// \brief Zero-copy reader for NMEA capture files
+class TinyGPSLogReader {
+public:
+  /// Constructor
+  TinyGPSLogReader() : mapping(NULL), length(0), cursor(0), opened(false) {}
+
+  /// Destructor. Unmaps the log.
+  ~TinyGPSLogReader() { close(); }
+
+  /// Map a log file, replacing any log mapped before.
+  /// \param path path of the log
+  /// \return false if the file could not be opened or mapped.
+  bool open(const char *path);
+
+  /// Unmap the log.
+  void close();
+
+  /// Query if a log is mapped.
+  /// \return true if a log is mapped, including an empty one.
+  bool isOpen() const { return opened; }
+
+  /// First character of the log
+  /// \return pointer into the mapping, NULL if nothing is mapped
+  const char *data() const { return (const char *)mapping; }
+
+  /// Length of the log
+  /// \return number of characters
+  size_t size() const { return length; }
+
+  /// Feed the whole log to a parser through
+  /// TinyGPSPlus::encode(const char *, size_t), straight from the mapping.
+  /// \param gps the parser
+  /// \param sliceSize number of characters passed to each encode() call
+  /// \return number of sentences that passed their checksum.
+  uint64_t encodeInto(TinyGPSPlus &gps, size_t sliceSize = 1 << 20) const;
+
+  /// Get the next sentence: from a '$' up to the line ending, the next '$'
+  /// or the end of the log, whichever comes first. Text outside sentences
+  /// is skipped.
+  /// \param begin set to the '$' of the sentence
+  /// \param end set to one past the last character of the sentence
+  /// \return false when there are no more sentences.
+  bool nextSentence(const char *&begin, const char *&end);
+
+  /// Get the next sentence, as nextSentence(const char *&, const char *&),
+  /// split into its terms.
+  /// \param sentence set to the sentence, with views into the mapping. Its
+  /// isValid() tells if the checksum matched.
+  /// \return false when there are no more sentences.
+  bool nextSentence(TinyGPSSentence &sentence) {
+    const char *begin, *end;
+    if (!nextSentence(begin, end))
+      return false;
+    sentence.parse(begin, end);
+    return true;
+  }
+
+  /// Restart nextSentence() from the beginning of the log.
+  void rewind() { cursor = 0; }
+
+#if __cplusplus >= 201703L
+  /// The whole log
+  /// \return view of the mapping
+  std::string_view view() const {
+    return std::string_view(data(), length);
+  }
+
+  /// Get the next sentence, as nextSentence(const char *&, const char *&).
+  /// \param sentence set to the sentence, pointing into the mapping
+  /// \return false when there are no more sentences.
+  bool nextSentence(std::string_view &sentence) {
+    const char *begin, *end;
+    if (!nextSentence(begin, end))
+      return false;
+    sentence = std::string_view(begin, end - begin);
+    return true;
+  }
+#endif
+
+private:
+  TinyGPSLogReader(const TinyGPSLogReader &);
+  TinyGPSLogReader &operator=(const TinyGPSLogReader &);
+
+  void *mapping;
+  size_t length;
+  size_t cursor;
+  bool opened;
+};
+
+#endif // _GPS_HOST_BUILD
+
+#endif // def(__TinyGPSLogReader_h)
@@ -0,0 +1,244 @@
+/*
+TinyGPS++ - a small GPS library for Arduino providing universal NMEA parsing
+Copyright (C) 2008-2013 Mikal Hart
+All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef __TinyGPSNumeric_h
+#define __TinyGPSNumeric_h
+
+/// \file
+/// \brief Numeric field parsing used by TinyGPSPlus::parseDecimal() and
+/// TinyGPSPlus::parseDegrees().
+///
+/// Digits are gathered eight at a time into a 64 bit word with one load,
+/// validated and converted with SIMD-within-a-register arithmetic. Only
+/// ASCII '0'-'9' count as digits, independent of the C locale, and nothing
+/// past the end of the input is read.
+
+#include <stdint.h>
+#include <string.h>
+
+/// \brief SWAR parser for the numeric fields of NMEA sentences
+///
+/// Each function takes either a NUL-terminated string or a range ending at
+/// end. Leading whitespace and a sign are accepted as atol() accepts them;
+/// parsing stops at the first character that is not a digit, or at end.
+class TinyGPSNumeric {
+public:
+  /// Parse an integer like (uint32_t)atol(): leading whitespace, an
+  /// optional sign, then digits.
+  /// \param p input, advanced past the characters consumed
+  /// \param end end of the input
+  /// \return the value, wrapped to 32 bits if negative
+  static uint32_t parseUnsigned(const char *&p, const char *end) {
+    bool negative = skipSign(p, end);
+    uint32_t value = parseDigits(p, end);
+    return negative ? 0 - value : value;
+  }
+
+  /// Parse a NUL-terminated integer like (uint32_t)atol().
+  /// \param p input, advanced past the characters consumed
+  /// \return the value, wrapped to 32 bits if negative
+  static uint32_t parseUnsigned(const char *&p) {
+    return parseUnsigned(p, p + strlen(p));
+  }
+
+  /// Parse a (potentially negative) number with up to 2 decimal digits
+  /// -xxxx.yy. Result is 100 times the value, for example 1234.56 is 123456.
+  /// The whole part is parsed as atol() parses it.
+  /// \param term text to parse
+  /// \param end end of the text
+  /// \return the decimal value.
+  static int32_t parseDecimal(const char *term, const char *end) {
+    bool negative = skipSign(term, end);
+    int32_t ret = 100 * (int32_t)parseDigits(term, end);
+    if (end - term >= 2 && *term == '.' && isDigit(term[1])) {
+      ret += 10 * (term[1] - '0');
+      if (end - term >= 3 && isDigit(term[2]))
+        ret += term[2] - '0';
+    }
+    return negative ? -ret : ret;
+  }
+
+  /// Parse a NUL-terminated decimal number, see above.
+  /// \param term text to parse
+  /// \return the decimal value.
+  static int32_t parseDecimal(const char *term) {
+    return parseDecimal(term, term + strlen(term));
+  }
+
+  /// Parse a (potentially negative) number with up to 3 decimal digits
+  /// -xxxx.yyy. Result is 1000 times the value, for example 0.006 is 6.
+  /// The whole part is parsed as atol() parses it.
+  /// \param term text to parse
+  /// \param end end of the text
+  /// \return the value in thousandths.
+  static int32_t parseThousandths(const char *term, const char *end) {
+    bool negative = skipSign(term, end);
+    int32_t ret = 1000 * (int32_t)parseDigits(term, end);
+    if (term < end && *term == '.') {
+      int32_t scale = 100;
+      for (++term; scale > 0 && term < end && isDigit(*term); scale /= 10)
+        ret += scale * (*term++ - '0');
+    }
+    return negative ? -ret : ret;
+  }
+
+  /// Parse degrees in NMEA format DDMM.MMMM. The first seven decimals of
+  /// the minutes are significant. Leading whitespace and a sign are skipped
+  /// as atol() skips them, but the sign is ignored: the hemisphere term
+  /// carries it.
+  /// \param term text to parse
+  /// \param end end of the text
+  /// \param deg set to the whole degrees
+  /// \param billionths set to the billionths of a degree
+  static void parseDegrees(const char *term, const char *end, uint16_t &deg,
+                           uint32_t &billionths) {
+    skipSign(term, end);
+    uint32_t leftOfDecimal = parseDigits(term, end);
+    uint32_t tenMillionthsOfMinutes = (leftOfDecimal % 100) * 10000000UL;
+    deg = (uint16_t)(leftOfDecimal / 100);
+
+    if (term < end && *term == '.') {
+      uint64_t chunk = load8(term + 1, end);
+      unsigned n = digitCount(chunk);
+      if (n > 7)
+        n = 7;
+      tenMillionthsOfMinutes += digitsValue(chunk, n) * powerOf10(7 - n);
+    }
+
+    billionths = (5 * tenMillionthsOfMinutes + 1) / 3;
+  }
+
+  /// Parse NUL-terminated degrees in NMEA format DDMM.MMMM, see above.
+  /// \param term text to parse
+  /// \param deg set to the whole degrees
+  /// \param billionths set to the billionths of a degree
+  static void parseDegrees(const char *term, uint16_t &deg,
+                           uint32_t &billionths) {
+    parseDegrees(term, term + strlen(term), deg, billionths);
+  }
+
+  /// Locale independent isdigit()
+  static bool isDigit(char c) { return (uint8_t)(c - '0') < 10; }
+
+  /// Skip leading whitespace and an optional sign, as atol() does.
+  /// \param p input, advanced past them
+  /// \param end end of the input
+  /// \return true if the sign was '-'
+  static bool skipSign(const char *&p, const char *end) {
+    while (p < end && (*p == ' ' || (uint8_t)(*p - '\t') < 5))
+      ++p;
+    bool negative = p < end && *p == '-';
+    if (p < end && (*p == '-' || *p == '+'))
+      ++p;
+    return negative;
+  }
+
+  /// Parse a run of digits, eight at a time.
+  /// \param p input, advanced past the digits
+  /// \param end end of the input
+  /// \return the value of the digits
+  static uint32_t parseDigits(const char *&p, const char *end) {
+    uint32_t value = 0;
+    for (;;) {
+      uint64_t chunk = load8(p, end);
+      unsigned n = digitCount(chunk);
+      value = value * powerOf10(n) + digitsValue(chunk, n);
+      p += n;
+      if (n < 8)
+        return value;
+    }
+  }
+
+  /// Gather the eight characters at p, or those before end if fewer, into a
+  /// word with the first character in the low byte and zeros after end. A
+  /// full word is one unaligned load.
+  static uint64_t load8(const char *p, const char *end) {
+    uint64_t chunk = 0;
+    if (end - p >= 8) {
+      memcpy(&chunk, p, 8);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+      chunk = __builtin_bswap64(chunk);
+#endif
+      return chunk;
+    }
+    // Most fields are shorter than a word. Gather the rest as at most one
+    // load each of 4, 2 and 1 bytes, as a variable length memcpy() would be
+    // a library call.
+    unsigned n = p < end ? (unsigned)(end - p) : 0, shift = 0;
+    if (n & 4) {
+      chunk = load<uint32_t>(p);
+      shift = 32;
+    }
+    if (n & 2) {
+      chunk |= (uint64_t)load<uint16_t>(p + shift / 8) << shift;
+      shift += 16;
+    }
+    if (n & 1)
+      chunk |= (uint64_t)(uint8_t)p[shift / 8] << shift;
+    return chunk;
+  }
+
+  /// Unaligned little endian load of a T from p
+  template <typename T> static T load(const char *p) {
+    T value;
+    memcpy(&value, p, sizeof(value));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    if (sizeof(value) == 4)
+      value = (T)__builtin_bswap32((uint32_t)value);
+    else if (sizeof(value) == 2)
+      value = (T)__builtin_bswap16((uint16_t)value);
+#endif
+    return value;
+  }
+
+  /// Number of leading ASCII digits in a word filled by load8().
+  static unsigned digitCount(uint64_t chunk) {
+    // A byte is a digit when its high nibble is 3 and its low nibble is at
+    // most 9; adding 6 to the low nibble carries into the high nibble
+    // exactly when it is not. Neither test can carry between bytes.
+    uint64_t notDigit =
+        ((chunk & 0xF0F0F0F0F0F0F0F0ULL) ^ 0x3030303030303030ULL) |
+        (((chunk & 0x0F0F0F0F0F0F0F0FULL) + 0x0606060606060606ULL) &
+         0xF0F0F0F0F0F0F0F0ULL);
+    return notDigit ? (unsigned)__builtin_ctzll(notDigit) / 8 : 8;
+  }
+
+  /// Value of the first n (0-8) digits of a word filled by load8().
+  static uint32_t digitsValue(uint64_t chunk, unsigned n) {
+    if (n == 0)
+      return 0;
+    // Right-align the digits behind leading zeros, then combine pairs of
+    // digits, pairs of pairs and finally the two halves.
+    uint64_t v = (chunk - 0x3030303030303030ULL) << (8 * (8 - n));
+    v = ((v & 0x0F0F0F0F0F0F0F0FULL) * 2561) >> 8;
+    v = ((v & 0x00FF00FF00FF00FFULL) * 6553601) >> 16;
+    return (uint32_t)(((v & 0x0000FFFF0000FFFFULL) * 42949672960001ULL) >> 32);
+  }
+
+  /// 10 to the power n, for n from 0 to 8
+  static uint32_t powerOf10(unsigned n) {
+    static const uint32_t powers[] = {1,       10,       100,     1000,
+                                      10000,   100000,   1000000, 10000000,
+                                      100000000};
+    return powers[n];
+  }
+};
+
+#endif // def(__TinyGPSNumeric_h)
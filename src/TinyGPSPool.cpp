@@ -0,0 +1,354 @@
+/*
+TinyGPS++ - a small GPS library for Arduino providing universal NMEA parsing
+Copyright (C) 2008-2013 Mikal Hart
+All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "TinyGPSPool.h"
+
+#ifdef _GPS_HOST_BUILD
+
+#include "TinyGPSScanner.h"
+
+/// \file
+/// \brief TinyGPSPool implementation file
+#include <string.h>
+
+int TinyGPSPoolConfig::addCustom(const char *sentenceName, int termNumber) {
+  if (termNumber < 0 || termNumber > UINT8_MAX)
+    return -1;
+  uint16_t handle = (uint16_t)fields.size();
+
+  // Find the sentence's group, or add one
+  size_t g = 0;
+  while (g < groups.size() && groups[g].name != sentenceName)
+    ++g;
+  if (g == groups.size()) {
+    Group group;
+    group.name = sentenceName;
+    group.key = TinyGPSPlus::customKey(sentenceName);
+    group.begin = group.end = (uint16_t)fields.size();
+    groups.push_back(group);
+  }
+
+  // Insert in term order within the group, then shift the later groups
+  uint16_t at = groups[g].begin;
+  while (at < groups[g].end && fields[at].termNumber <= termNumber)
+    ++at;
+  Field field = {(uint8_t)termNumber, handle};
+  fields.insert(fields.begin() + at, field);
+  ++groups[g].end;
+  for (size_t i = 0; i < groups.size(); ++i)
+    if (i != g && groups[i].begin >= at) {
+      ++groups[i].begin;
+      ++groups[i].end;
+    }
+
+  return handle;
+}
+
+TinyGPSPool::TinyGPSPool(const TinyGPSPoolConfig &_config, size_t streamCount)
+    : config(_config), streams(streamCount),
+      customValues(streamCount * config.customCount() * 2 * customSize),
+      commitHook(NULL), commitContext(NULL) {
+  for (size_t i = 0; i < streamCount; ++i) {
+    memset(&streams[i], 0, sizeof(Stream));
+    streams[i].sentenceType = TinyGPSPlus::GPS_SENTENCE_OTHER;
+  }
+}
+
+uint32_t TinyGPSPool::feed(size_t stream, const char *buffer, size_t length) {
+  Stream &s = streams[stream];
+  const char *p = buffer;
+  const char *end = buffer + length;
+  uint32_t validSentences = 0;
+
+  while (p < end) {
+    // Consume a run of ordinary characters in one go
+    const char *run = p;
+    uint8_t runParity = 0;
+    p = TinyGPSScanner::findDelimiter(p, end, runParity);
+
+    size_t room = (sizeof(s.term) - 1) - s.termOffset;
+    size_t count = (size_t)(p - run) < room ? (size_t)(p - run) : room;
+    memcpy(s.term + s.termOffset, run, count);
+    s.termOffset += count;
+    if (!(s.flags & CHECKSUM_TERM))
+      s.parity ^= runParity;
+
+    if (p == end)
+      break;
+
+    char c = *p++;
+    if (c == '$') {
+      s.termNumber = s.termOffset = 0;
+      s.parity = 0;
+      s.sentenceType = TinyGPSPlus::GPS_SENTENCE_OTHER;
+      s.flags &= ~(CHECKSUM_TERM | HAS_FIX);
+    } else {
+      if (c == ',')
+        s.parity ^= (uint8_t)c;
+      if (endOfTerm(s, stream, c))
+        ++validSentences;
+    }
+  }
+
+  return validSentences;
+}
+
+// Finishes the current term of a stream at delimiter c, as
+// TinyGPSPlus::endOfTerm()
+bool TinyGPSPool::endOfTerm(Stream &s, size_t stream, char c) {
+  bool isValidSentence = false;
+  if (s.termOffset < sizeof(s.term)) {
+    s.term[s.termOffset] = 0;
+    isValidSentence = endOfTermHandler(s, stream);
+  }
+  ++s.termNumber;
+  s.termOffset = 0;
+  if (c == '*')
+    s.flags |= CHECKSUM_TERM;
+  else
+    s.flags &= ~CHECKSUM_TERM;
+  return isValidSentence;
+}
+
+// Stages the decoded terms of a stream. Only the fields of TinyGPSFix are
+// kept.
+struct TinyGPSPool::TermSink {
+  Stream &s;
+
+  // Records the STAGED_* bits of a staged value
+  void staged(uint16_t bits) {
+    s.staged.set |= bits;
+    s.staged.reverted &= ~bits;
+  }
+
+  void time(uint32_t value) {
+    s.staged.time = value;
+    staged(STAGED_TIME);
+  }
+  void date(uint32_t value) {
+    s.staged.date = value;
+    staged(STAGED_DATE);
+  }
+  void day(uint32_t value) {
+    s.staged.date = TinyGPSPlus::dateWithDay(s.staged.date, value);
+    staged(STAGED_DAY);
+  }
+  void month(uint32_t value) {
+    s.staged.date = TinyGPSPlus::dateWithMonth(s.staged.date, value);
+    staged(STAGED_MONTH);
+  }
+  void year(uint32_t value) {
+    s.staged.date = TinyGPSPlus::dateWithYear(s.staged.date, (uint16_t)value);
+    staged(STAGED_YEAR);
+  }
+  void zoneHours(bool, uint8_t) {}
+  void zoneMinutes(uint8_t) {}
+  void latitude(const RawDegrees &deg) {
+    s.staged.latitude = deg.deg * 1000000000ULL + deg.billionths;
+    s.staged.hemisphere &= ~SOUTH;
+    staged(STAGED_LATITUDE | STAGED_SOUTH);
+  }
+  void south(bool south) {
+    if (south)
+      s.staged.hemisphere |= SOUTH;
+    else
+      s.staged.hemisphere &= ~SOUTH;
+    staged(STAGED_SOUTH);
+  }
+  void longitude(const RawDegrees &deg) {
+    s.staged.longitude = deg.deg * 1000000000ULL + deg.billionths;
+    s.staged.hemisphere &= ~WEST;
+    staged(STAGED_LONGITUDE | STAGED_WEST);
+  }
+  void west(bool west) {
+    if (west)
+      s.staged.hemisphere |= WEST;
+    else
+      s.staged.hemisphere &= ~WEST;
+    staged(STAGED_WEST);
+  }
+  void speed(int32_t value) {
+    s.staged.speed = value;
+    staged(STAGED_SPEED);
+  }
+  void course(int32_t value) {
+    s.staged.course = value;
+    staged(STAGED_COURSE);
+  }
+  void altitude(int32_t value) {
+    s.staged.altitude = value;
+    staged(STAGED_ALTITUDE);
+  }
+  void satellites(uint32_t value) {
+    s.staged.satellites = value < 0xFFFF ? (uint16_t)value : 0xFFFF;
+    staged(STAGED_SATELLITES);
+  }
+  void hdop(int32_t value) {
+    s.staged.hdop = value;
+    staged(STAGED_HDOP);
+  }
+  void pdop(int32_t) {}
+  void vdop(int32_t) {}
+  void fixMode(uint32_t) {}
+  void active(uint8_t) {}
+  void hasFix(bool hasFix) { setHasFix(s, hasFix); }
+  void errorStat(uint8_t, int32_t) {}
+};
+
+// Processes a just-completed term of a stream, as
+// TinyGPSPlus::endOfTermHandler()
+bool TinyGPSPool::endOfTermHandler(Stream &s, size_t stream) {
+  const char *term = s.term;
+
+  if (s.flags & CHECKSUM_TERM) {
+    if (TinyGPSPlus::checksumMatches(term[0], term[1], s.parity)) {
+      ++s.passedChecksumCount;
+      commit(s, stream);
+      return true;
+    }
+    ++s.failedChecksumCount;
+    discard(s, stream);
+    return false;
+  }
+
+  if (s.termNumber == 0) {
+    s.sentenceType = TinyGPSPlus::sentenceType(term);
+
+    s.customGroup = 0;
+    if (!config.groups.empty()) {
+      uint64_t key = TinyGPSPlus::customKey(term);
+      for (size_t g = 0; g < config.groups.size(); ++g) {
+        const TinyGPSPoolConfig::Group &group = config.groups[g];
+        if (group.key == key && (s.termOffset < 8 || group.name == term)) {
+          s.customGroup = (uint16_t)(g + 1);
+          s.customCursor = group.begin;
+          break;
+        }
+      }
+    }
+    return false;
+  }
+
+  TermSink sink = {s};
+  TinyGPSPlus::decodeTerm(s.sentenceType, s.termNumber,
+                          TinyGPSField(term, s.termOffset), sink);
+
+  // Stage custom values; the cursor only ever moves forward
+  if (s.customGroup) {
+    const TinyGPSPoolConfig::Group &group = config.groups[s.customGroup - 1];
+    const TinyGPSPoolConfig::Field *fields = config.fields.data();
+    while (s.customCursor != group.end &&
+           fields[s.customCursor].termNumber < s.termNumber)
+      ++s.customCursor;
+    for (; s.customCursor != group.end &&
+           fields[s.customCursor].termNumber == s.termNumber;
+         ++s.customCursor)
+      strncpy(customStaging(stream, fields[s.customCursor].handle), term,
+              customSize);
+  }
+
+  return false;
+}
+
+// Puts the staged values of a stream back to its committed ones after a
+// sentence fails its checksum, as TinyGPSPlus::discardSentence()
+void TinyGPSPool::discard(Stream &s, size_t stream) {
+  Staging &staged = s.staged;
+  const TinyGPSFix &fix = s.fix;
+  staged.latitude = fix.latitude < 0 ? 0 - (uint64_t)fix.latitude
+                                     : (uint64_t)fix.latitude;
+  staged.longitude = fix.longitude < 0 ? 0 - (uint64_t)fix.longitude
+                                       : (uint64_t)fix.longitude;
+  staged.hemisphere =
+      (fix.latitude < 0 ? SOUTH : 0) | (fix.longitude < 0 ? WEST : 0);
+  staged.date = fix.date;
+  staged.time = fix.time;
+  staged.speed = fix.speed;
+  staged.course = fix.course;
+  staged.altitude = fix.altitude;
+  staged.hdop = fix.hdop;
+  staged.satellites = fix.satellites;
+  staged.set = 0;
+  staged.reverted = STAGED_ALL;
+
+  for (size_t i = 0; i < config.customCount(); ++i) {
+    char *staging = customStaging(stream, (int)i);
+    memcpy(staging, staging + customSize, customSize);
+  }
+
+  s.sentenceType = TinyGPSPlus::GPS_SENTENCE_OTHER;
+  s.customGroup = 0;
+  setHasFix(s, false);
+}
+
+// Commits the staged values of a stream's validated sentence
+void TinyGPSPool::commit(Stream &s, size_t stream) {
+  const Staging &staged = s.staged;
+  TinyGPSFix &fix = s.fix;
+  bool hasFix = s.flags & HAS_FIX;
+  uint8_t committed = 0;
+
+  // TinyGPSFix has the first eight fields of TinyGPSPlus
+  if (s.sentenceType != TinyGPSPlus::GPS_SENTENCE_OTHER) {
+    const TinyGPSPlus::CommitRule &rule =
+        TinyGPSPlus::commitMap[s.sentenceType];
+    committed = (uint8_t)(rule.always | (hasFix ? rule.withFix : 0));
+  }
+
+  if (committed & TinyGPSFix::DATE)
+    fix.date = staged.date;
+  if (committed & TinyGPSFix::TIME)
+    fix.time = staged.time;
+  if (committed & TinyGPSFix::SPEED)
+    fix.speed = staged.speed;
+  if (committed & TinyGPSFix::COURSE)
+    fix.course = staged.course;
+  if (committed & TinyGPSFix::ALTITUDE)
+    fix.altitude = staged.altitude;
+  if (committed & TinyGPSFix::SATELLITES)
+    fix.satellites = staged.satellites;
+  if (committed & TinyGPSFix::HDOP)
+    fix.hdop = staged.hdop;
+  if (committed & TinyGPSFix::LOCATION) {
+    fix.latitude = staged.hemisphere & SOUTH ? -(int64_t)staged.latitude
+                                             : (int64_t)staged.latitude;
+    fix.longitude = staged.hemisphere & WEST ? -(int64_t)staged.longitude
+                                             : (int64_t)staged.longitude;
+  }
+
+  if (commitHook)
+    commitHook(commitContext, stream, staged, committed);
+
+  if (s.customGroup) {
+    const TinyGPSPoolConfig::Group &group = config.groups[s.customGroup - 1];
+    for (uint16_t i = group.begin; i != group.end; ++i) {
+      char *staging = customStaging(stream, config.fields[i].handle);
+      memcpy(staging + customSize, staging, customSize);
+    }
+  }
+
+  if (committed || s.customGroup) {
+    fix.valid |= committed;
+    fix.updated |= committed;
+    fix.commitTime = TinyGPSClock::now();
+  }
+}
+
+#endif // _GPS_HOST_BUILD
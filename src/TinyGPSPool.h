@@ -0,0 +1,240 @@
+/*
+TinyGPS++ - a small GPS library for Arduino providing universal NMEA parsing
+Copyright (C) 2008-2013 Mikal Hart
+All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef __TinyGPSPool_h
+#define __TinyGPSPool_h
+
+/// \file
+/// \brief Parser pool for many independent receiver streams (host builds
+/// only).
+///
+/// A TinyGPSPlus carries its own copy of every TinyGPSCustom and of every
+/// staged and committed value, which adds up when thousands of receivers are
+/// ingested at once. TinyGPSPool splits that into an immutable
+/// TinyGPSPoolConfig, shared by every stream, and a small fixed-size state
+/// per stream: the partial term being parsed, the staged values of the
+/// current sentence and the latest committed fix.
+
+#include "TinyGPS++.h"
+
+#ifdef _GPS_HOST_BUILD
+
+#include <string>
+#include <vector>
+
+/// \brief Configuration shared by every stream of one or more TinyGPSPools
+///
+/// Holds the custom field layout. A configuration must not change while a
+/// TinyGPSPool built from it exists.
+class TinyGPSPoolConfig {
+public:
+  /// Register a custom field, like TinyGPSCustom::begin(). Term numbers
+  /// are counted in 8 bits, so a term past 255 is rejected.
+  /// \param sentenceName the name of the sentence, for example "GPGSA"
+  /// \param termNumber the number of the term to capture, 0 to 255
+  /// \return the field handle to pass to TinyGPSPool::custom(), or -1 if
+  /// termNumber is out of range.
+  int addCustom(const char *sentenceName, int termNumber);
+
+  /// Number of registered custom fields
+  /// \return count of custom fields
+  size_t customCount() const { return fields.size(); }
+
+private:
+  friend class TinyGPSPool;
+
+  struct Field {
+    uint8_t termNumber;
+    uint16_t handle;
+  };
+
+  // Fields of one sentence, fields[begin, end) sorted by term number
+  struct Group {
+    std::string name;
+    uint64_t key;
+    uint16_t begin, end;
+  };
+
+  std::vector<Field> fields;
+  std::vector<Group> groups;
+};
+
+/// \brief Parser state and latest fix for many independent NMEA streams
+///
+/// Each stream behaves like its own TinyGPSPlus fed through
+/// TinyGPSPlus::encode(const char *, size_t): it decodes every sentence type
+/// TinyGPSPlus maps, but keeps only the fields of TinyGPSFix, plus the
+/// custom fields of the configuration. Streams are independent: different
+/// streams may be fed from different threads, but each stream must only be
+/// fed by one thread at a time.
+class TinyGPSPool {
+public:
+  /// Constructor
+  /// \param config the shared configuration, which must outlive the pool
+  /// \param streamCount number of streams, numbered from 0
+  TinyGPSPool(const TinyGPSPoolConfig &config, size_t streamCount);
+
+  /// Number of streams
+  /// \return stream count
+  size_t size() const { return streams.size(); }
+
+  /// Process a chunk of characters received on one stream.
+  /// \param stream stream number
+  /// \param buffer input characters
+  /// \param length number of characters in buffer
+  /// \return number of sentences that passed their checksum in buffer.
+  uint32_t feed(size_t stream, const char *buffer, size_t length);
+
+  /// Latest committed fix of a stream
+  /// \param stream stream number
+  /// \return the fix
+  const TinyGPSFix &fix(size_t stream) const {
+    return streams[stream].fix;
+  }
+
+  /// Clear the updated mask of a stream's fix.
+  /// \param stream stream number
+  void clearUpdated(size_t stream) { streams[stream].fix.updated = 0; }
+
+  /// Latest committed value of a custom field of a stream.
+  /// \param stream stream number
+  /// \param field handle returned by TinyGPSPoolConfig::addCustom()
+  /// \return the value, or an empty string if it was never committed.
+  const char *custom(size_t stream, int field) const {
+    return customValue(stream, field);
+  }
+
+  /// Number of sentences of a stream that passed their checksum
+  /// \param stream stream number
+  /// \return count of passed checksums
+  uint32_t passedChecksum(size_t stream) const {
+    return streams[stream].passedChecksumCount;
+  }
+
+  /// Number of sentences of a stream that failed their checksum
+  /// \param stream stream number
+  /// \return count of failed checksums
+  uint32_t failedChecksum(size_t stream) const {
+    return streams[stream].failedChecksumCount;
+  }
+
+  /// Memory used per stream, including its custom field values
+  /// \return bytes per stream
+  size_t bytesPerStream() const {
+    return sizeof(Stream) + 2 * customSize * config.customCount();
+  }
+
+private:
+  friend class TinyGPSReplay;
+
+  enum { CHECKSUM_TERM = 1, HAS_FIX = 2 };
+  enum { SOUTH = 1, WEST = 2 };
+  static const size_t customSize = _GPS_MAX_FIELD_SIZE + 1;
+
+  // Bits of Staging::set
+  enum {
+    STAGED_TIME = 1 << 0,
+    STAGED_DATE = 1 << 1,
+    STAGED_LATITUDE = 1 << 2,
+    STAGED_LONGITUDE = 1 << 3,
+    STAGED_SOUTH = 1 << 4,
+    STAGED_WEST = 1 << 5,
+    STAGED_SPEED = 1 << 6,
+    STAGED_COURSE = 1 << 7,
+    STAGED_ALTITUDE = 1 << 8,
+    STAGED_HDOP = 1 << 9,
+    STAGED_SATELLITES = 1 << 10,
+    STAGED_DAY = 1 << 11, // parts of the date, from ZDA
+    STAGED_MONTH = 1 << 12,
+    STAGED_YEAR = 1 << 13,
+    STAGED_ALL = (1 << 14) - 1
+  };
+
+  // Values staged by the sentences parsed so far, committed by a sentence
+  // whose checksum passes. Like TinyGPSPlus, a value stays staged until a
+  // later sentence replaces it, or a sentence that fails its checksum puts
+  // it back to the committed value. set records which values have been
+  // staged since the stream was created or a sentence last failed, and
+  // reverted which values that failure put back and were not staged since;
+  // TinyGPSReplay uses them to stitch chunks parsed from a blank state back
+  // together.
+  struct Staging {
+    uint64_t latitude, longitude; // billionths of a degree
+    uint32_t date, time;
+    int32_t speed, course, altitude, hdop;
+    uint16_t satellites;
+    uint16_t set, reverted;
+    uint8_t hemisphere;
+  };
+
+  // Called with the staging of every commit, for TinyGPSReplay
+  typedef void (*CommitHook)(void *context, size_t stream,
+                             const Staging &staged, uint8_t committed);
+
+  struct Stream {
+    char term[_GPS_MAX_FIELD_SIZE];
+    uint8_t parity;
+    uint8_t termNumber;
+    uint8_t termOffset;
+    uint8_t sentenceType;
+    uint8_t flags;
+    uint16_t customGroup; // group index + 1, 0 if none
+    uint16_t customCursor;
+    uint32_t passedChecksumCount;
+    uint32_t failedChecksumCount;
+    Staging staged;
+    TinyGPSFix fix;
+  };
+
+  const TinyGPSPoolConfig &config;
+  std::vector<Stream> streams;
+  // Staging and committed value of every custom field of every stream
+  std::vector<char> customValues;
+  CommitHook commitHook;
+  void *commitContext;
+
+  char *customStaging(size_t stream, int field) {
+    return &customValues[(stream * config.customCount() + field) * 2 *
+                         customSize];
+  }
+  const char *customValue(size_t stream, int field) const {
+    return &customValues[(stream * config.customCount() + field) * 2 *
+                             customSize +
+                         customSize];
+  }
+
+  static void setHasFix(Stream &s, bool hasFix) {
+    if (hasFix)
+      s.flags |= HAS_FIX;
+    else
+      s.flags &= ~HAS_FIX;
+  }
+
+  struct TermSink;
+
+  bool endOfTerm(Stream &s, size_t stream, char c);
+  bool endOfTermHandler(Stream &s, size_t stream);
+  void discard(Stream &s, size_t stream);
+  void commit(Stream &s, size_t stream);
+};
+
+#endif // _GPS_HOST_BUILD
+
+#endif // def(__TinyGPSPool_h)
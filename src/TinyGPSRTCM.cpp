@@ -0,0 +1,156 @@
+/*
+TinyGPS++ - a small GPS library for Arduino providing universal NMEA parsing
+Copyright (C) 2008-2013 Mikal Hart
+All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "TinyGPSRTCM.h"
+
+/// \file
+/// \brief TinyGPSRTCM implementation file
+
+/// CRC-24Q (polynomial 0x1864CFB) of each nibble, small enough for AVR RAM
+static const uint32_t crcNibbles[16] = {
+    0x000000, 0x864CFB, 0x8AD50D, 0x0C99F6, 0x93E6E1, 0x15AA1A,
+    0x1933EC, 0x9F7F17, 0xA18139, 0x27CDC2, 0x2B5434, 0xAD18CF,
+    0x3267D8, 0xB42B23, 0xB8B2D5, 0x3EFE2E};
+
+uint32_t TinyGPSRTCM::crc24q(uint32_t crc, uint8_t c) {
+  crc = (crc << 4 ^ crcNibbles[(crc >> 20 ^ c >> 4) & 0xF]) & 0xFFFFFF;
+  return (crc << 4 ^ crcNibbles[(crc >> 20 ^ c) & 0xF]) & 0xFFFFFF;
+}
+
+uint32_t TinyGPSRTCM::crc24q(uint32_t crc, const uint8_t *data,
+                             size_t length) {
+  for (size_t i = 0; i < length; ++i)
+    crc = crc24q(crc, data[i]);
+  return crc;
+}
+
+uint32_t TinyGPSRTCM::framesOfType(uint16_t messageType) const {
+  for (uint8_t i = 0; i < typesCounted; ++i)
+    if (types[i] == messageType)
+      return typeFrames[i];
+  return 0;
+}
+
+uint8_t TinyGPSRTCM::encode(uint8_t c) {
+  if (!framing) {
+    if (c != PREAMBLE)
+      return NOT_RTCM;
+    framing = true;
+    received = 0;
+    crc = 0;
+  } else if (received == 1 && (c & 0xFC)) {
+    // Nonzero reserved bits: the preamble was line noise
+    framing = false;
+    return NOT_RTCM;
+  }
+
+#if _GPS_RTCM_REASSEMBLY
+  frame[received] = c;
+#endif
+  uint16_t i = received++;
+
+  if (i < 3) {
+    if (i == 1) {
+      length = (uint16_t)c << 8;
+    } else if (i == 2) {
+      length |= c;
+      type = 0;
+    }
+    crc = crc24q(crc, c);
+    return IN_FRAME;
+  }
+
+  if (i < length + 3) {
+    // The message type is the first 12 bits of the payload; a payload of
+    // one character has none
+    if (i == 3 && length >= 2)
+      type = (uint16_t)c << 4;
+    else if (i == 4)
+      type |= c >> 4;
+    crc = crc24q(crc, c);
+    return IN_FRAME;
+  }
+
+  receivedCRC = receivedCRC << 8 | c;
+  if (i < length + 5)
+    return IN_FRAME;
+  framing = false;
+#if _GPS_RTCM_REASSEMBLY
+  return endOfFrame(frame, (receivedCRC & 0xFFFFFF) == crc);
+#else
+  return endOfFrame(NULL, (receivedCRC & 0xFFFFFF) == crc);
+#endif
+}
+
+const char *TinyGPSRTCM::encode(const char *p, const char *end,
+                                uint8_t &status) {
+  const uint8_t *q = (const uint8_t *)p;
+  size_t available = (size_t)(end - p);
+
+  // A frame held whole in the buffer is checked and forwarded in place
+  if (!framing && available >= 6 && q[0] == PREAMBLE && !(q[1] & 0xFC)) {
+    size_t n = ((size_t)q[1] << 8 | q[2]) + 6;
+    if (available >= n) {
+      length = (uint16_t)(n - 6);
+      type = length >= 2 ? (uint16_t)(q[3] << 4 | q[4] >> 4) : 0;
+      uint32_t expected =
+          (uint32_t)q[n - 3] << 16 | (uint32_t)q[n - 2] << 8 | q[n - 1];
+      status = endOfFrame(q, crc24q(0, q, n - 3) == expected);
+      return p + n;
+    }
+  }
+
+  status = IN_FRAME;
+  while (p < end) {
+    status = encode((uint8_t)*p);
+    if (status == NOT_RTCM)
+      return p;
+    ++p;
+    if (status != IN_FRAME)
+      return p;
+  }
+  return p;
+}
+
+// Counts a complete frame and forwards it if it passed. data is NULL when
+// the frame was fed a character at a time without reassembly.
+uint8_t TinyGPSRTCM::endOfFrame(const uint8_t *data, bool passed) {
+  if (!passed) {
+    ++failedCount;
+    return FAILED;
+  }
+
+  ++passedCount;
+  lastType = type;
+  uint8_t i = 0;
+  while (i < typesCounted && types[i] != type)
+    ++i;
+  if (i < typesCounted) {
+    ++typeFrames[i];
+  } else if (typesCounted < _GPS_RTCM_MAX_TYPES) {
+    types[i] = type;
+    typeFrames[i] = 1;
+    ++typesCounted;
+  }
+
+  if (callback != NULL && data != NULL)
+    callback(data, (size_t)length + 6, type, callbackContext);
+  return PASSED;
+}
@@ -0,0 +1,163 @@
+/*
+TinyGPS++ - a small GPS library for Arduino providing universal NMEA parsing
+Copyright (C) 2008-2013 Mikal Hart
+All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef __TinyGPSRTCM_h
+#define __TinyGPSRTCM_h
+
+/// \file
+/// \brief RTCM3 framing for correction data mixed into the NMEA stream.
+///
+/// An RTCM3 frame is the preamble 0xD3, six reserved zero bits and a 10 bit
+/// payload length, the payload, whose first 12 bits are the message type,
+/// and a CRC-24Q over everything before it. TinyGPSPlus steps over each
+/// frame as a whole, so a '$' or line ending inside the binary payload never
+/// reaches the NMEA parser, and hands frames that pass their CRC on intact.
+
+#include "TinyGPSConfig.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/// \brief RTCM3 frame counter and forwarder
+///
+/// Frames that pass their CRC are counted per message type and, if a
+/// callback is set, forwarded. A frame that lies whole in a buffer given to
+/// TinyGPSPlus::encode(const char *, size_t) is forwarded in place, without
+/// copying. Frames split across buffers or fed to encode(char) are
+/// reassembled first, when _GPS_RTCM_REASSEMBLY is set, and only counted
+/// otherwise.
+class TinyGPSRTCM {
+public:
+  /// Result of encode()
+  enum Status {
+    NOT_RTCM, ///< the character is not part of a frame
+    IN_FRAME, ///< the character was taken by a frame in progress
+    PASSED,   ///< the character ended a frame that passed its CRC
+    FAILED    ///< the character ended a frame that failed its CRC
+  };
+
+  /// Preamble, which starts every frame
+  static const uint8_t PREAMBLE = 0xD3;
+  /// Longest frame: 3 header, 1023 payload and 3 CRC bytes
+  static const size_t MAX_FRAME = 1029;
+
+  /// Called for every frame that passes its CRC
+  /// \param frame the whole frame, preamble to CRC. Only valid during the
+  /// call.
+  /// \param length length of the frame
+  /// \param messageType message type of the frame
+  /// \param context as passed to forward()
+  typedef void (*FrameCallback)(const uint8_t *frame, size_t length,
+                                uint16_t messageType, void *context);
+
+  /// Constructor
+  TinyGPSRTCM()
+      : callback(0), callbackContext(0), framing(false), received(0),
+        length(0), type(0), lastType(0), crc(0), receivedCRC(0),
+        passedCount(0), failedCount(0), typesCounted(0) {}
+
+  /// Forward the frames that pass their CRC.
+  /// \param frameCallback called for every frame, or NULL to stop
+  /// \param context passed to frameCallback
+  void forward(FrameCallback frameCallback, void *context) {
+    callback = frameCallback;
+    callbackContext = context;
+  }
+
+  /// Process one character of the stream.
+  /// \param c the character
+  /// \return a Status. NOT_RTCM means the character belongs to the NMEA
+  /// stream.
+  uint8_t encode(uint8_t c);
+
+  /// Process the characters of a frame in progress, as encode(uint8_t) for
+  /// each, up to the end of the frame. A frame held whole in the buffer is
+  /// checked and forwarded in place.
+  /// \param p first character
+  /// \param end end of the buffer
+  /// \param status set to the status of the last character processed,
+  /// IN_FRAME if the frame continues beyond end
+  /// \return pointer past the last character taken. A character that
+  /// returned NOT_RTCM is not taken.
+  const char *encode(const char *p, const char *end, uint8_t &status);
+
+  /// Query if a frame is in progress
+  /// \return true if the next character goes to the frame.
+  bool inFrame() const { return framing; }
+
+  /// Number of frames that passed their CRC
+  /// \return count of frames
+  uint32_t passedFrames() const { return passedCount; }
+
+  /// Number of frames that failed their CRC
+  /// \return count of frames
+  uint32_t failedFrames() const { return failedCount; }
+
+  /// Message type of the last frame that passed its CRC
+  /// \return message type, 0 if none
+  uint16_t lastMessageType() const { return lastType; }
+
+  /// Number of distinct message types counted, at most
+  /// _GPS_RTCM_MAX_TYPES
+  /// \return count of message types
+  uint8_t typeCount() const { return typesCounted; }
+
+  /// Message type counted at an index
+  /// \param i index from 0 to typeCount() - 1, in order of first arrival
+  /// \return message type
+  uint16_t messageType(uint8_t i) const { return types[i]; }
+
+  /// Frames that passed their CRC for the message type at an index
+  /// \param i index from 0 to typeCount() - 1
+  /// \return count of frames
+  uint32_t frames(uint8_t i) const { return typeFrames[i]; }
+
+  /// Frames that passed their CRC for a message type
+  /// \param messageType the message type
+  /// \return count of frames, 0 if the type was never seen or not counted
+  uint32_t framesOfType(uint16_t messageType) const;
+
+  /// CRC-24Q of a run of characters
+  /// \param crc CRC of the characters before, 0 to start
+  /// \param data the characters
+  /// \param length number of characters
+  /// \return the CRC
+  static uint32_t crc24q(uint32_t crc, const uint8_t *data, size_t length);
+
+private:
+  FrameCallback callback;
+  void *callbackContext;
+  bool framing;
+  uint16_t received; // characters of the frame so far
+  uint16_t length;   // of the payload
+  uint16_t type, lastType;
+  uint32_t crc, receivedCRC;
+  uint32_t passedCount, failedCount;
+  uint8_t typesCounted;
+  uint16_t types[_GPS_RTCM_MAX_TYPES];
+  uint32_t typeFrames[_GPS_RTCM_MAX_TYPES];
+#if _GPS_RTCM_REASSEMBLY
+  uint8_t frame[MAX_FRAME];
+#endif
+
+  static uint32_t crc24q(uint32_t crc, uint8_t c);
+  uint8_t endOfFrame(const uint8_t *data, bool passed);
+};
+
+#endif // def(__TinyGPSRTCM_h)
@@ -0,0 +1,210 @@
+/*
+TinyGPS++ - a small GPS library for Arduino providing universal NMEA parsing
+Copyright (C) 2008-2013 Mikal Hart
+All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "TinyGPSReplay.h"
+
+#ifdef _GPS_HOST_BUILD
+
+#include "TinyGPSLogReader.h"
+
+/// \file
+/// \brief TinyGPSReplay implementation file
+#include <atomic>
+#include <string.h>
+#include <thread>
+
+TinyGPSReplay::TinyGPSReplay(unsigned threads, size_t _chunkSize)
+    : threadCount(threads ? threads : 1),
+      chunkSize(_chunkSize ? _chunkSize : 1), passedChecksumCount(0),
+      failedChecksumCount(0) {
+  memset(&carried, 0, sizeof(carried));
+  memset(&currentFix, 0, sizeof(currentFix));
+}
+
+bool TinyGPSReplay::replayFile(const char *path, FixCallback callback,
+                               void *context) {
+  TinyGPSLogReader reader;
+  if (!reader.open(path))
+    return false;
+  replay(reader.data(), reader.size(), callback, context);
+  return true;
+}
+
+// Collects the commits of each chunk, indexed by its pool stream
+void TinyGPSReplay::record(void *context, size_t chunk, const Staging &staged,
+                           uint8_t committed) {
+  std::vector<std::vector<Commit>> &commits =
+      *(std::vector<std::vector<Commit>> *)context;
+  Commit c;
+  c.staged = staged;
+  c.committed = committed;
+  commits[chunk].push_back(c);
+}
+
+// Overlays the values staged in a chunk onto the staging carried into it.
+// Values a failed sentence put back to the committed ones come from fix,
+// the fix merged so far.
+void TinyGPSReplay::stitch(Staging &base, const Staging &local,
+                           const TinyGPSFix &fix) {
+  uint16_t reverted = local.reverted;
+  if (reverted & TinyGPSPool::STAGED_TIME)
+    base.time = fix.time;
+  if (reverted & TinyGPSPool::STAGED_DATE)
+    base.date = fix.date;
+  if (reverted & TinyGPSPool::STAGED_LATITUDE)
+    base.latitude = fix.latitude < 0 ? 0 - (uint64_t)fix.latitude
+                                     : (uint64_t)fix.latitude;
+  if (reverted & TinyGPSPool::STAGED_LONGITUDE)
+    base.longitude = fix.longitude < 0 ? 0 - (uint64_t)fix.longitude
+                                       : (uint64_t)fix.longitude;
+  if (reverted & TinyGPSPool::STAGED_SOUTH)
+    base.hemisphere = (base.hemisphere & ~TinyGPSPool::SOUTH) |
+                      (fix.latitude < 0 ? TinyGPSPool::SOUTH : 0);
+  if (reverted & TinyGPSPool::STAGED_WEST)
+    base.hemisphere = (base.hemisphere & ~TinyGPSPool::WEST) |
+                      (fix.longitude < 0 ? TinyGPSPool::WEST : 0);
+  if (reverted & TinyGPSPool::STAGED_SPEED)
+    base.speed = fix.speed;
+  if (reverted & TinyGPSPool::STAGED_COURSE)
+    base.course = fix.course;
+  if (reverted & TinyGPSPool::STAGED_ALTITUDE)
+    base.altitude = fix.altitude;
+  if (reverted & TinyGPSPool::STAGED_HDOP)
+    base.hdop = fix.hdop;
+  if (reverted & TinyGPSPool::STAGED_SATELLITES)
+    base.satellites = fix.satellites;
+
+  uint16_t set = local.set;
+  if (set & TinyGPSPool::STAGED_TIME)
+    base.time = local.time;
+  if (set & TinyGPSPool::STAGED_DATE) {
+    base.date = local.date;
+  } else {
+    // Only parts of the date were staged, ddmmyy
+    if (set & TinyGPSPool::STAGED_DAY)
+      base.date = TinyGPSPlus::dateWithDay(base.date, local.date / 10000);
+    if (set & TinyGPSPool::STAGED_MONTH)
+      base.date =
+          TinyGPSPlus::dateWithMonth(base.date, local.date / 100 % 100);
+    if (set & TinyGPSPool::STAGED_YEAR)
+      base.date = TinyGPSPlus::dateWithYear(base.date, local.date % 100);
+  }
+  if (set & TinyGPSPool::STAGED_LATITUDE)
+    base.latitude = local.latitude;
+  if (set & TinyGPSPool::STAGED_LONGITUDE)
+    base.longitude = local.longitude;
+  if (set & TinyGPSPool::STAGED_SOUTH)
+    base.hemisphere = (base.hemisphere & ~TinyGPSPool::SOUTH) |
+                      (local.hemisphere & TinyGPSPool::SOUTH);
+  if (set & TinyGPSPool::STAGED_WEST)
+    base.hemisphere = (base.hemisphere & ~TinyGPSPool::WEST) |
+                      (local.hemisphere & TinyGPSPool::WEST);
+  if (set & TinyGPSPool::STAGED_SPEED)
+    base.speed = local.speed;
+  if (set & TinyGPSPool::STAGED_COURSE)
+    base.course = local.course;
+  if (set & TinyGPSPool::STAGED_ALTITUDE)
+    base.altitude = local.altitude;
+  if (set & TinyGPSPool::STAGED_HDOP)
+    base.hdop = local.hdop;
+  if (set & TinyGPSPool::STAGED_SATELLITES)
+    base.satellites = local.satellites;
+  base.set |= set;
+}
+
+void TinyGPSReplay::replay(const char *data, size_t length,
+                           FixCallback callback, void *context) {
+  const char *end = data + length;
+  const char *p = data;
+
+  while (p < end) {
+    // Cut the next window of chunks, each ending just before a '$'
+    std::vector<const char *> bounds(1, p);
+    size_t maxChunks = 2 * (size_t)threadCount;
+    while (p < end && bounds.size() <= maxChunks) {
+      p = (size_t)(end - p) > chunkSize ? p + chunkSize : end;
+      const char *next = p < end ? (const char *)memchr(p, '$', end - p) : 0;
+      p = next ? next : end;
+      bounds.push_back(p);
+    }
+    size_t chunks = bounds.size() - 1;
+
+    // Parse the chunks in parallel, each into its own pool stream
+    TinyGPSPool pool(config, chunks);
+    std::vector<std::vector<Commit>> commits(chunks);
+    pool.commitHook = record;
+    pool.commitContext = &commits;
+
+    std::atomic<size_t> nextChunk(0);
+    auto work = [&]() {
+      for (size_t i; (i = nextChunk.fetch_add(1)) < chunks;)
+        pool.feed(i, bounds[i], bounds[i + 1] - bounds[i]);
+    };
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < threadCount && t < chunks; ++t)
+      threads.push_back(std::thread(work));
+    work();
+    for (size_t t = 0; t < threads.size(); ++t)
+      threads[t].join();
+
+    // Merge in file order
+    for (size_t i = 0; i < chunks; ++i) {
+      for (size_t c = 0; c < commits[i].size(); ++c) {
+        Staging staged = carried;
+        stitch(staged, commits[i][c].staged, currentFix);
+        uint8_t committed = commits[i][c].committed;
+
+        TinyGPSFix &fix = currentFix;
+        if (committed & TinyGPSFix::LOCATION) {
+          fix.latitude = staged.hemisphere & TinyGPSPool::SOUTH
+                             ? -(int64_t)staged.latitude
+                             : (int64_t)staged.latitude;
+          fix.longitude = staged.hemisphere & TinyGPSPool::WEST
+                              ? -(int64_t)staged.longitude
+                              : (int64_t)staged.longitude;
+        }
+        if (committed & TinyGPSFix::DATE)
+          fix.date = staged.date;
+        if (committed & TinyGPSFix::TIME)
+          fix.time = staged.time;
+        if (committed & TinyGPSFix::SPEED)
+          fix.speed = staged.speed;
+        if (committed & TinyGPSFix::COURSE)
+          fix.course = staged.course;
+        if (committed & TinyGPSFix::ALTITUDE)
+          fix.altitude = staged.altitude;
+        if (committed & TinyGPSFix::SATELLITES)
+          fix.satellites = staged.satellites;
+        if (committed & TinyGPSFix::HDOP)
+          fix.hdop = staged.hdop;
+        fix.valid |= committed;
+        fix.updated = committed;
+        fix.commitTime = (uint32_t)++passedChecksumCount;
+
+        if (callback)
+          callback(fix, context);
+      }
+      stitch(carried, pool.streams[i].staged, currentFix);
+      failedChecksumCount += pool.failedChecksum(i);
+    }
+  }
+}
+
+#endif // _GPS_HOST_BUILD
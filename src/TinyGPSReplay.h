@@ -0,0 +1,118 @@
+/*
+TinyGPS++ - a small GPS library for Arduino providing universal NMEA parsing
+Copyright (C) 2008-2013 Mikal Hart
+All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef __TinyGPSReplay_h
+#define __TinyGPSReplay_h
+
+/// \file
+/// \brief Parallel replay of recorded NMEA logs (host builds only).
+///
+/// The log is split into chunks at '$' sentence starts and the chunks are
+/// parsed in parallel, each from a blank parser state. A value staged by one
+/// sentence can be committed by a later one, possibly in a later chunk, so
+/// every commit is recorded together with the staged values it used and
+/// which of them were staged inside its own chunk. Merging the chunks in
+/// file order fills in the rest from the state carried over from the
+/// previous chunks, which gives exactly the fixes of a sequential replay.
+///
+/// Only NMEA text is decoded. UBX and RTCM frames are read as text, as
+/// TinyGPSPool reads them, so a '$' inside one can start a chunk and a
+/// NAV-PVT frame does not update the fix. Logs with binary frames replay as
+/// one TinyGPSPool stream would parse them, not as TinyGPSPlus would.
+
+#include "TinyGPSPool.h"
+
+#ifdef _GPS_HOST_BUILD
+
+#include <vector>
+
+/// \brief Parallel chunked replay of an NMEA log
+///
+/// Decodes the same fields as TinyGPSPool, without custom fields. Every
+/// sentence that passes its checksum is reported in file order with the
+/// fix as it stands after that sentence. In these fixes, updated holds the
+/// fields committed by that sentence alone, and commitTime is the number of
+/// validated sentences so far, so ages are measured in sentences rather
+/// than milliseconds.
+class TinyGPSReplay {
+public:
+  /// Called for every validated sentence, in file order
+  typedef void (*FixCallback)(const TinyGPSFix &fix, void *context);
+
+  /// Constructor
+  /// \param threads number of parser threads, at least 1
+  /// \param chunkSize approximate number of bytes per chunk
+  explicit TinyGPSReplay(unsigned threads, size_t chunkSize = 4 << 20);
+
+  /// Replay a log file, memory-mapped with TinyGPSLogReader.
+  /// \param path path of the log
+  /// \param callback called for every validated sentence, or NULL
+  /// \param context passed to callback
+  /// \return false if the file could not be opened or mapped.
+  bool replayFile(const char *path, FixCallback callback, void *context);
+
+  /// Replay a log held in memory. Consecutive calls continue the same
+  /// replay, provided each buffer ends at a sentence boundary.
+  /// \param data log contents
+  /// \param length number of characters in data
+  /// \param callback called for every validated sentence, or NULL
+  /// \param context passed to callback
+  void replay(const char *data, size_t length, FixCallback callback,
+              void *context);
+
+  /// Fix after the last validated sentence replayed
+  /// \return the fix
+  const TinyGPSFix &fix() const { return currentFix; }
+
+  /// Number of sentences that passed their checksum
+  /// \return count of passed checksums
+  uint64_t passedChecksum() const { return passedChecksumCount; }
+
+  /// Number of sentences that failed their checksum
+  /// \return count of failed checksums
+  uint64_t failedChecksum() const { return failedChecksumCount; }
+
+private:
+  typedef TinyGPSPool::Staging Staging;
+
+  // A commit within a chunk, with the chunk-local staging it used
+  struct Commit {
+    Staging staged;
+    uint8_t committed;
+  };
+
+  unsigned threadCount;
+  size_t chunkSize;
+  TinyGPSPoolConfig config;
+
+  Staging carried; // staging at the end of everything merged so far
+  TinyGPSFix currentFix;
+  uint64_t passedChecksumCount;
+  uint64_t failedChecksumCount;
+
+  static void record(void *context, size_t chunk, const Staging &staged,
+                     uint8_t committed);
+  static void stitch(Staging &base, const Staging &local,
+                     const TinyGPSFix &fix);
+};
+
+#endif // _GPS_HOST_BUILD
+
+#endif // def(__TinyGPSReplay_h)
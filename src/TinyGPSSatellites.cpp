@@ -0,0 +1,302 @@
+/*
+TinyGPS++ - a small GPS library for Arduino providing universal NMEA parsing
+Copyright (C) 2008-2013 Mikal Hart
+All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "TinyGPSSatellites.h"
+#include "TinyGPSNumeric.h"
+
+/// \file
+/// \brief TinyGPSSatellites implementation file
+#include <string.h>
+
+// Talker IDs of the GSV sentences, kept with each satellite so a group only
+// replaces the satellites of its own talker
+enum { TALKER_GP, TALKER_GN, TALKER_GL, TALKER_GA, TALKER_GB, TALKER_GQ };
+
+TinyGPSSatellites::TinyGPSSatellites()
+    : messageSlots(0), messageTalker(0), messageCount(0), messageNumber(0),
+      groupTalker(0), groupCount(0), groupNext(0), activeCount(0),
+      activeTalker(0), activeSystem(0), runTalkers(0), inRun(false),
+      valid(false), updated(false), lastCommitTime(0) {
+  table.count = group.count = 0;
+  memset(used, 0, sizeof(used));
+  memset(usedMerged, 0, sizeof(usedMerged));
+}
+
+TinyGPSSatellites::TinyGPSSatellites(TinyGPSPlus &gps) : TinyGPSSatellites() {
+  begin(gps);
+}
+
+void TinyGPSSatellites::begin(TinyGPSPlus &gps) { gps.satelliteTable = this; }
+
+// Called with the address field of a GSV sentence, which sentenceType()
+// has already checked
+uint8_t TinyGPSSatellites::talkerOf(const char *address) {
+  if (address[0] == 'B')
+    return TALKER_GB; // BD, legacy BeiDou
+  switch (address[1]) {
+  case 'N':
+    return TALKER_GN;
+  case 'L':
+    return TALKER_GL;
+  case 'A':
+    return TALKER_GA;
+  case 'B':
+    return TALKER_GB;
+  case 'Q':
+    return TALKER_GQ;
+  default:
+    return TALKER_GP;
+  }
+}
+
+// GP and GN groups mix systems, told apart by the NMEA PRN ranges
+// (including the u-blox extended ranges for Galileo and BeiDou)
+uint8_t TinyGPSSatellites::constellationOf(uint8_t talker, uint16_t prn) {
+  switch (talker) {
+  case TALKER_GL:
+    return GLONASS;
+  case TALKER_GA:
+    return GALILEO;
+  case TALKER_GB:
+    return BEIDOU;
+  case TALKER_GQ:
+    return QZSS;
+  }
+  if (prn >= 1 && prn <= 32)
+    return GPS;
+  if ((prn >= 33 && prn <= 64) || (prn >= 120 && prn <= 158))
+    return SBAS;
+  if (prn >= 65 && prn <= 96)
+    return GLONASS;
+  if (prn >= 193 && prn <= 202)
+    return QZSS;
+  if (prn >= 301 && prn <= 336)
+    return GALILEO;
+  if (prn >= 401 && prn <= 437)
+    return BEIDOU;
+  return UNKNOWN;
+}
+
+void TinyGPSSatellites::beginMessage(const char *address) {
+  messageTalker = talkerOf(address);
+  messageSlots = messageCount = messageNumber = 0;
+}
+
+// GSV fields have at most three digits, too few for the SWAR kernels of
+// TinyGPSNumeric to pay off
+static uint16_t smallNumber(const char *p) {
+  uint16_t v = 0;
+  while (TinyGPSNumeric::isDigit(*p))
+    v = v * 10 + (*p++ - '0');
+  return v;
+}
+
+// Terms 1 to 3 give the number of messages in the group, the number of this
+// message and the satellites in view; then come up to four satellites of
+// four terms each: PRN, elevation, azimuth and SNR.
+void TinyGPSSatellites::setTerm(uint8_t termNumber, const char *term) {
+  if (termNumber < 4) {
+    if (termNumber == 1)
+      messageCount = (uint8_t)smallNumber(term);
+    else if (termNumber == 2)
+      messageNumber = (uint8_t)smallNumber(term);
+    return;
+  }
+
+  unsigned slot = (termNumber - 4) / 4;
+  if (slot >= 4)
+    return;
+  switch ((termNumber - 4) % 4) {
+  case 0:
+    if (term[0]) {
+      messagePrn[slot] = smallNumber(term);
+      messageElevation[slot] = 0;
+      messageAzimuth[slot] = 0;
+      messageSnr[slot] = 0;
+      messageSlots |= 1 << slot;
+    }
+    break;
+  case 1:
+    messageElevation[slot] = term[0] == '-' ? -(int8_t)smallNumber(term + 1)
+                                            : (int8_t)smallNumber(term);
+    break;
+  case 2:
+    messageAzimuth[slot] = smallNumber(term);
+    break;
+  case 3:
+    messageSnr[slot] = (uint8_t)smallNumber(term);
+    break;
+  }
+}
+
+// Called when a GSV sentence passes its checksum. termCount counts the
+// address field and every data field.
+void TinyGPSSatellites::commitMessage(uint8_t termCount, uint32_t now) {
+  if (messageNumber == 1) {
+    group.count = 0;
+    groupTalker = messageTalker;
+    groupCount = messageCount;
+    groupNext = 1;
+  }
+  if (messageNumber == 0 || messageNumber != groupNext ||
+      messageTalker != groupTalker || messageCount != groupCount) {
+    groupNext = 0;
+    return;
+  }
+
+  // Only whole satellites count: an NMEA 4.10 signal ID after the last one
+  // was taken for another PRN above
+  unsigned dataTerms = termCount - 1;
+  unsigned slots = dataTerms > 3 ? (dataTerms - 3) / 4 : 0;
+  uint8_t present = messageSlots & ((1 << (slots < 4 ? slots : 4)) - 1);
+
+  for (unsigned slot = 0; slot < 4; ++slot)
+    if ((present & (1 << slot)) && group.count < _GPS_MAX_SATELLITES) {
+      uint8_t i = group.count++;
+      group.prn[i] = messagePrn[slot];
+      group.elevation[i] = messageElevation[slot];
+      group.azimuth[i] = messageAzimuth[slot];
+      group.snr[i] = messageSnr[slot];
+      group.system[i] = (uint8_t)(messageTalker << 4) |
+                        constellationOf(messageTalker, messagePrn[slot]);
+    }
+
+  if (messageNumber == groupCount) {
+    commitGroup(now);
+    groupNext = 0;
+  } else {
+    ++groupNext;
+  }
+}
+
+// Replaces the satellites of the group's talker with the group
+void TinyGPSSatellites::commitGroup(uint32_t now) {
+  uint8_t n = 0;
+  for (uint8_t i = 0; i < table.count; ++i)
+    if ((table.system[i] >> 4) != groupTalker) {
+      table.prn[n] = table.prn[i];
+      table.elevation[n] = table.elevation[i];
+      table.azimuth[n] = table.azimuth[i];
+      table.snr[n] = table.snr[i];
+      table.system[n] = table.system[i];
+      ++n;
+    }
+
+  for (uint8_t i = 0; i < group.count && n < _GPS_MAX_SATELLITES; ++i, ++n) {
+    table.prn[n] = group.prn[i];
+    table.elevation[n] = group.elevation[i];
+    table.azimuth[n] = group.azimuth[i];
+    table.snr[n] = group.snr[i];
+    table.system[n] = group.system[i];
+  }
+  table.count = n;
+
+  lastCommitTime = now;
+  valid = updated = true;
+}
+
+// Receivers number the satellites of a system in more than one way: SBAS
+// as PRN 120-158 or as NMEA 33-64, Galileo as 1-36 or 301-336, and so on.
+// The bit is the satellite's number within its system, the same in every
+// numbering, so that SBAS 120-127 do not share bits with 56-63 and a
+// satellite listed under either number is the same one.
+uint8_t TinyGPSSatellites::usedBit(uint8_t constellation, uint16_t prn) {
+  switch (constellation) {
+  case SBAS:
+    if (prn >= 120)
+      prn -= 120;
+    else if (prn >= 33)
+      prn -= 33;
+    break;
+  case GLONASS:
+    if (prn >= 65)
+      prn -= 64;
+    break;
+  case GALILEO:
+    if (prn >= 301)
+      prn -= 300;
+    break;
+  case BEIDOU:
+    if (prn >= 401)
+      prn -= 400;
+    else if (prn >= 201)
+      prn -= 200;
+    break;
+  case QZSS:
+    if (prn >= 193)
+      prn -= 192;
+    break;
+  }
+  return (uint8_t)(prn % 64);
+}
+
+uint8_t TinyGPSSatellites::usedCount() const {
+  uint8_t n = 0;
+  for (uint8_t c = 0; c < UNKNOWN; ++c)
+    n += (uint8_t)__builtin_popcountll(used[c]);
+  return n;
+}
+
+// Called for the address field of every sentence. Anything but GSA ends the
+// current run of GSA sentences.
+void TinyGPSSatellites::beginActive(const char *address, bool isGSA) {
+  if (!isGSA) {
+    inRun = false;
+    return;
+  }
+  activeTalker = talkerOf(address);
+  activeCount = activeSystem = 0;
+}
+
+// Terms 3 to 14 are the PRNs of the satellites used; empty ones are not
+// passed on. Term 18 is the NMEA 4.10 system ID.
+void TinyGPSSatellites::setActiveTerm(uint8_t termNumber, const char *term) {
+  if (termNumber == 18)
+    activeSystem = (uint8_t)smallNumber(term);
+  else if (activeCount < 12)
+    activePrn[activeCount++] = smallNumber(term);
+}
+
+// Called when a GSA sentence passes its checksum
+void TinyGPSSatellites::commitActive() {
+  // NMEA 4.10 system IDs 1 to 5: GPS, GLONASS, Galileo, BeiDou, QZSS
+  static const uint8_t systemTalkers[] = {TALKER_GN, TALKER_GP, TALKER_GL,
+                                          TALKER_GA, TALKER_GB, TALKER_GQ};
+  uint8_t talker =
+      activeSystem >= 1 && activeSystem <= 5 ? systemTalkers[activeSystem]
+                                             : activeTalker;
+
+  // A talker seen again starts the next epoch. GN sentences without a
+  // system ID cannot be told apart, so they only end at another sentence.
+  uint8_t talkerBit = talker == TALKER_GN ? 0 : 1 << talker;
+  if (!inRun || (runTalkers & talkerBit)) {
+    memset(usedMerged, 0, sizeof(usedMerged));
+    runTalkers = 0;
+    inRun = true;
+  }
+  runTalkers |= talkerBit;
+
+  for (uint8_t i = 0; i < activeCount; ++i) {
+    uint8_t c = constellationOf(talker, activePrn[i]);
+    if (c < UNKNOWN)
+      usedMerged[c] |= 1ULL << usedBit(c, activePrn[i]);
+  }
+  memcpy(used, usedMerged, sizeof(used));
+}
@@ -0,0 +1,195 @@
+/*
+TinyGPS++ - a small GPS library for Arduino providing universal NMEA parsing
+Copyright (C) 2008-2013 Mikal Hart
+All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef __TinyGPSSatellites_h
+#define __TinyGPSSatellites_h
+
+/// \file
+/// \brief Satellites in view, decoded from GSV sentences.
+
+#include "TinyGPS++.h"
+
+/// \brief Table of the satellites in view
+///
+/// Attached to a TinyGPSPlus like TinyGPSCustom, so sketches that do not
+/// track satellites pay nothing for it. Each talker (GP, GL, GA, ...) sends
+/// its satellites as a group of GSV messages. The messages of a group are
+/// staged as they pass their checksum, and the group replaces that talker's
+/// satellites in the table when its last message arrives, so the table never
+/// holds half a group. A group with a missing or corrupted message is
+/// dropped.
+///
+/// The table is stored as parallel arrays indexed from 0 to count() - 1.
+///
+/// GSA sentences mark the satellites used in the solution. Consecutive GSA
+/// sentences, such as the GNGSA sentence per constellation sent by
+/// multi-constellation receivers, are merged into one set, which is
+/// published as each of them passes its checksum.
+class TinyGPSSatellites {
+public:
+  /// Satellite systems
+  enum Constellation {
+    GPS,
+    SBAS,
+    GLONASS,
+    GALILEO,
+    BEIDOU,
+    QZSS,
+    UNKNOWN
+  };
+
+  /// Constructor. Call begin() before use.
+  TinyGPSSatellites();
+
+  /// Constructor
+  /// \param gps the TinyGPSPlus class to do parsing.
+  explicit TinyGPSSatellites(TinyGPSPlus &gps);
+
+  /// Start decoding the GSV sentences seen by gps. Useful if the default
+  /// constructor was used. A TinyGPSPlus feeds at most one table.
+  /// \param gps the TinyGPSPlus class to do parsing.
+  void begin(TinyGPSPlus &gps);
+
+  /// Query if the table is valid.
+  /// \return true if at least one group has been committed.
+  bool isValid() const { return valid; }
+
+  /// Query if the table has been updated.
+  /// \return true if a group has been committed since count() was called.
+  bool isUpdated() const { return updated; }
+
+  /// Get the age of the table in milliseconds
+  /// \return age in milliseconds if valid. ULONG_MAX otherwise.
+  uint32_t age() const {
+    return valid ? TinyGPSClock::now() - lastCommitTime : (uint32_t)ULONG_MAX;
+  }
+
+  /// Get the number of satellites in the table and mark it as not updated.
+  /// \return number of satellites
+  uint8_t count() {
+    updated = false;
+    return static_cast<const TinyGPSSatellites &>(*this).count();
+  }
+
+  /// Get the number of satellites in the table without marking it as not
+  /// updated.
+  /// \return number of satellites
+  uint8_t count() const { return table.count; }
+
+  /// Mark the table as not updated, as count() does.
+  void consume() { updated = false; }
+
+  /// Satellite ID as sent by the receiver
+  /// \param i index, less than count()
+  /// \return the PRN
+  uint16_t prn(uint8_t i) const { return table.prn[i]; }
+
+  /// Elevation in degrees
+  /// \param i index, less than count()
+  /// \return elevation, 90 maximum
+  int8_t elevation(uint8_t i) const { return table.elevation[i]; }
+
+  /// Azimuth in degrees from true north
+  /// \param i index, less than count()
+  /// \return azimuth, 0 to 359
+  uint16_t azimuth(uint8_t i) const { return table.azimuth[i]; }
+
+  /// Signal to noise ratio in dB-Hz
+  /// \param i index, less than count()
+  /// \return SNR, 0 when the satellite is not tracked
+  uint8_t snr(uint8_t i) const { return table.snr[i]; }
+
+  /// Satellite system, from the talker ID or, for GP and GN talkers, from
+  /// the PRN range.
+  /// \param i index, less than count()
+  /// \return one of the Constellation values
+  uint8_t constellation(uint8_t i) const { return table.system[i] & 0x0F; }
+
+  /// Query if a satellite of the table is used in the solution.
+  /// \param i index, less than count()
+  /// \return true if the latest GSA sentences list it.
+  bool isUsed(uint8_t i) const { return isUsed(constellation(i), prn(i)); }
+
+  /// Query if a satellite is used in the solution, whether or not it is in
+  /// the table.
+  /// \param constellation one of the Constellation values
+  /// \param prn satellite ID as sent by the receiver
+  /// \return true if the latest GSA sentences list it.
+  bool isUsed(uint8_t constellation, uint16_t prn) const {
+    return constellation < UNKNOWN &&
+           ((used[constellation] >> usedBit(constellation, prn)) & 1) != 0;
+  }
+
+  /// Number of satellites used in the solution
+  /// \return count of satellites listed by the latest GSA sentences
+  uint8_t usedCount() const;
+
+private:
+  friend class TinyGPSPlus;
+
+  struct Table {
+    uint16_t prn[_GPS_MAX_SATELLITES];
+    uint16_t azimuth[_GPS_MAX_SATELLITES];
+    int8_t elevation[_GPS_MAX_SATELLITES];
+    uint8_t snr[_GPS_MAX_SATELLITES];
+    uint8_t system[_GPS_MAX_SATELLITES]; // constellation, talker << 4
+    uint8_t count;
+  };
+
+  Table table; // committed
+  Table group; // messages of the group in progress
+
+  // Current message
+  uint16_t messagePrn[4], messageAzimuth[4];
+  int8_t messageElevation[4];
+  uint8_t messageSnr[4];
+  uint8_t messageSlots; // bit per slot whose PRN was received
+  uint8_t messageTalker, messageCount, messageNumber;
+
+  uint8_t groupTalker, groupCount;
+  uint8_t groupNext; // next message number expected, 0 if none
+
+  // Satellites used, one bit per satellite of each constellation, see
+  // usedBit()
+  uint64_t used[UNKNOWN];       // published
+  uint64_t usedMerged[UNKNOWN]; // merged over the current run of GSA
+
+  // Current GSA sentence
+  uint16_t activePrn[12];
+  uint8_t activeCount, activeTalker, activeSystem;
+  uint8_t runTalkers; // bit per talker merged in the current run
+  bool inRun;
+
+  bool valid, updated;
+  uint32_t lastCommitTime;
+
+  void beginMessage(const char *address);
+  void setTerm(uint8_t termNumber, const char *term);
+  void commitMessage(uint8_t termCount, uint32_t now);
+  void commitGroup(uint32_t now);
+  void beginActive(const char *address, bool isGSA);
+  void setActiveTerm(uint8_t termNumber, const char *term);
+  void commitActive();
+  static uint8_t talkerOf(const char *address);
+  static uint8_t constellationOf(uint8_t talker, uint16_t prn);
+  static uint8_t usedBit(uint8_t constellation, uint16_t prn);
+};
+
+#endif // def(__TinyGPSSatellites_h)
@@ -0,0 +1,239 @@
+/*
+TinyGPS++ - a small GPS library for Arduino providing universal NMEA parsing
+Copyright (C) 2008-2013 Mikal Hart
+All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef __TinyGPSScanner_h
+#define __TinyGPSScanner_h
+
+/// \file
+/// \brief Delimiter scanner used by the bulk TinyGPSPlus::encode() path.
+///
+/// Finds the next NMEA term delimiter (',', '\\r', '\\n', '*' or '$') and
+/// folds the XOR parity of every character skipped on the way. The same scan
+/// without ',' as a stop finds the checksum of a whole sentence. Either scan
+/// can also stop at characters with their high bit set, which start the
+/// binary frames mixed into the stream, at no extra cost. On x86-64 hosts
+/// the scans run 32 (AVX2) or 16 (SSE2) bytes at a time; all other targets
+/// use the scalar loop.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define _GPS_SCAN_AVX2 1
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define _GPS_SCAN_SSE2 1
+#endif
+
+/// \brief Vectorized term delimiter scanner
+class TinyGPSScanner {
+public:
+  /// True for the characters that encode(char) treats specially.
+  /// All of them sit below 64, so a single shift tests them.
+  static bool isDelimiter(char c) {
+    const uint64_t delimiters = (1ULL << ',') | (1ULL << '\r') |
+                                (1ULL << '\n') | (1ULL << '*') | (1ULL << '$');
+    return (uint8_t)c < 64 && ((delimiters >> (uint8_t)c) & 1);
+  }
+
+  /// True for the delimiters that end a sentence body: all of
+  /// isDelimiter() except ','.
+  static bool isSentenceDelimiter(char c) {
+    return c != ',' && isDelimiter(c);
+  }
+
+  /// Find the next delimiter in [p, end).
+  /// \param p start of the scan
+  /// \param end end of the buffer
+  /// \param parity XOR of every character before the returned position is
+  /// folded into this value
+  /// \return pointer to the delimiter, or end if there is none
+  static const char *findDelimiter(const char *p, const char *end,
+                                   uint8_t &parity) {
+    return find<true, false>(p, end, parity);
+  }
+
+  /// findDelimiter() that also stops at a character with its high bit set.
+  /// NMEA is ASCII, so such a character starts a binary frame (UBX, RTCM3)
+  /// or is line noise.
+  /// \param p start of the scan
+  /// \param end end of the buffer
+  /// \param parity XOR of every character before the returned position is
+  /// folded into this value
+  /// \return pointer to the delimiter or high-bit character, or end
+  static const char *findDelimiterOrBinary(const char *p, const char *end,
+                                           uint8_t &parity) {
+    return find<true, true>(p, end, parity);
+  }
+
+  /// Find the end of a sentence body: the next '*', '\\r', '\\n' or '$' in
+  /// [p, end). Commas are folded into the parity like any other character.
+  /// \param p start of the scan
+  /// \param end end of the buffer
+  /// \param parity XOR of every character before the returned position is
+  /// folded into this value
+  /// \return pointer to the delimiter, or end if there is none
+  static const char *findSentenceEnd(const char *p, const char *end,
+                                     uint8_t &parity) {
+    return find<false, false>(p, end, parity);
+  }
+
+  /// findSentenceEnd() that also stops at a character with its high bit
+  /// set, see findDelimiterOrBinary().
+  /// \param p start of the scan
+  /// \param end end of the buffer
+  /// \param parity XOR of every character before the returned position is
+  /// folded into this value
+  /// \return pointer to the delimiter or high-bit character, or end
+  static const char *findSentenceEndOrBinary(const char *p, const char *end,
+                                             uint8_t &parity) {
+    return find<false, true>(p, end, parity);
+  }
+
+  /// Scalar version of findDelimiter(), also used for the tail of the
+  /// vectorized scans.
+  static const char *findDelimiterScalar(const char *p, const char *end,
+                                         uint8_t &parity) {
+    return findScalar<true, false>(p, end, parity);
+  }
+
+private:
+  template <bool StopAtComma, bool StopAtBinary>
+  static const char *find(const char *p, const char *end, uint8_t &parity) {
+#if defined(_GPS_SCAN_AVX2)
+    p = findAVX2<StopAtComma, StopAtBinary>(p, end, parity);
+#elif defined(_GPS_SCAN_SSE2)
+    p = findSSE2<StopAtComma, StopAtBinary>(p, end, parity);
+#endif
+    return findScalar<StopAtComma, StopAtBinary>(p, end, parity);
+  }
+
+  template <bool StopAtComma, bool StopAtBinary>
+  static const char *findScalar(const char *p, const char *end,
+                                uint8_t &parity) {
+    uint8_t x = 0;
+    while (p < end &&
+           !(StopAtComma ? isDelimiter(*p) : isSentenceDelimiter(*p)) &&
+           !(StopAtBinary && (*p & 0x80)))
+      x ^= (uint8_t)*p++;
+    parity ^= x;
+    return p;
+  }
+
+  /// Mask selecting the first n bytes of a block: load 32 bytes starting at
+  /// prefixMask + 32 - n.
+  static const uint8_t *prefixMask() {
+    static const uint8_t mask[64] = {
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    return mask;
+  }
+
+#if defined(_GPS_SCAN_SSE2) || defined(_GPS_SCAN_AVX2)
+  static uint8_t foldParity(__m128i x) {
+    x = _mm_xor_si128(x, _mm_srli_si128(x, 8));
+    x = _mm_xor_si128(x, _mm_srli_si128(x, 4));
+    x = _mm_xor_si128(x, _mm_srli_si128(x, 2));
+    x = _mm_xor_si128(x, _mm_srli_si128(x, 1));
+    return (uint8_t)_mm_cvtsi128_si32(x);
+  }
+
+  // Stops have their high bit set. A character's own high bit is one when
+  // StopAtBinary, so it only takes an OR.
+  template <bool StopAtComma, bool StopAtBinary>
+  static __m128i delimiterMask(__m128i v) {
+    __m128i m = _mm_cmpeq_epi8(v, _mm_set1_epi8('\r'));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('\n')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('*')));
+    m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('$')));
+    if (StopAtComma)
+      m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8(',')));
+    if (StopAtBinary)
+      m = _mm_or_si128(m, v);
+    return m;
+  }
+
+  template <bool StopAtComma, bool StopAtBinary>
+  static const char *findSSE2(const char *p, const char *end,
+                              uint8_t &parity) {
+    __m128i x = _mm_setzero_si128();
+    while (end - p >= 16) {
+      __m128i v = _mm_loadu_si128((const __m128i *)p);
+      unsigned hits = (unsigned)_mm_movemask_epi8(
+          delimiterMask<StopAtComma, StopAtBinary>(v));
+      if (hits) {
+        unsigned n = (unsigned)__builtin_ctz(hits);
+        __m128i keep = _mm_loadu_si128(
+            (const __m128i *)(prefixMask() + 32 - n));
+        x = _mm_xor_si128(x, _mm_and_si128(v, keep));
+        parity ^= foldParity(x);
+        return p + n;
+      }
+      x = _mm_xor_si128(x, v);
+      p += 16;
+    }
+    parity ^= foldParity(x);
+    return p;
+  }
+#endif
+
+#if defined(_GPS_SCAN_AVX2)
+  template <bool StopAtComma, bool StopAtBinary>
+  static const char *findAVX2(const char *p, const char *end,
+                              uint8_t &parity) {
+    const __m256i comma = _mm256_set1_epi8(',');
+    const __m256i cr = _mm256_set1_epi8('\r');
+    const __m256i lf = _mm256_set1_epi8('\n');
+    const __m256i star = _mm256_set1_epi8('*');
+    const __m256i dollar = _mm256_set1_epi8('$');
+    __m256i x = _mm256_setzero_si256();
+    while (end - p >= 32) {
+      __m256i v = _mm256_loadu_si256((const __m256i *)p);
+      __m256i m = _mm256_or_si256(
+          _mm256_or_si256(_mm256_cmpeq_epi8(v, cr), _mm256_cmpeq_epi8(v, lf)),
+          _mm256_or_si256(_mm256_cmpeq_epi8(v, star),
+                          _mm256_cmpeq_epi8(v, dollar)));
+      if (StopAtComma)
+        m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, comma));
+      if (StopAtBinary)
+        m = _mm256_or_si256(m, v);
+      unsigned hits = (unsigned)_mm256_movemask_epi8(m);
+      if (hits) {
+        unsigned n = (unsigned)__builtin_ctz(hits);
+        __m256i keep = _mm256_loadu_si256(
+            (const __m256i *)(prefixMask() + 32 - n));
+        x = _mm256_xor_si256(x, _mm256_and_si256(v, keep));
+        parity ^= foldParity(_mm_xor_si128(_mm256_castsi256_si128(x),
+                                           _mm256_extracti128_si256(x, 1)));
+        return p + n;
+      }
+      x = _mm256_xor_si256(x, v);
+      p += 32;
+    }
+    parity ^= foldParity(_mm_xor_si128(_mm256_castsi256_si128(x),
+                                       _mm256_extracti128_si256(x, 1)));
+    return findSSE2<StopAtComma, StopAtBinary>(p, end, parity);
+  }
+#endif
+};
+
+#endif // def(__TinyGPSScanner_h)
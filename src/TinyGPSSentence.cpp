@@ -0,0 +1,74 @@
+/*
+TinyGPS++ - a small GPS library for Arduino providing universal NMEA parsing
+Copyright (C) 2008-2013 Mikal Hart
+All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "TinyGPSSentence.h"
+#include "TinyGPSScanner.h"
+
+/// \file
+/// \brief TinyGPSSentence implementation file
+#include <string.h>
+
+bool TinyGPSSentence::parse(const char *begin, const char *end) {
+  termCount = 0;
+  truncated = valid = false;
+  checksumField = TinyGPSField();
+
+  if (begin < end && *begin == '$')
+    ++begin;
+
+  // Terms end at ','; the first other delimiter ends the sentence body
+  uint8_t parity = 0;
+  const char *p = begin;
+  for (;;) {
+    const char *q = TinyGPSScanner::findDelimiter(p, end, parity);
+    if (termCount < _GPS_MAX_SENTENCE_TERMS)
+      terms[termCount++] = TinyGPSField(p, q - p);
+    else
+      truncated = true;
+    p = q;
+    if (p == end || *p != ',')
+      break;
+    parity ^= (uint8_t)',';
+    ++p;
+  }
+
+  const TinyGPSField &address = terms[0];
+  size_t talkerLength = address.size() > 0 && address[0] == 'P' ? 1 : 2;
+  if (talkerLength > address.size())
+    talkerLength = address.size();
+  talkerField = TinyGPSField(address.data(), talkerLength);
+  formatterField = TinyGPSField(address.data() + talkerLength,
+                                address.size() - talkerLength);
+
+  if (p == end || *p != '*')
+    return false;
+
+  uint8_t ignored = 0;
+  const char *q = TinyGPSScanner::findDelimiter(p + 1, end, ignored);
+  checksumField = TinyGPSField(p + 1, q - (p + 1));
+  char hi = checksumField.size() > 0 ? checksumField[0] : '\0';
+  char lo = checksumField.size() > 1 ? checksumField[1] : '\0';
+  valid = TinyGPSPlus::checksumMatches(hi, lo, parity);
+  return valid;
+}
+
+bool TinyGPSSentence::parse(const char *line) {
+  return parse(line, line + strlen(line));
+}
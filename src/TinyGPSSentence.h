@@ -0,0 +1,108 @@
+/*
+TinyGPS++ - a small GPS library for Arduino providing universal NMEA parsing
+Copyright (C) 2008-2013 Mikal Hart
+All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef __TinyGPSSentence_h
+#define __TinyGPSSentence_h
+
+/// \file
+/// \brief Sentence-level parsing into zero-copy field views.
+///
+/// Where TinyGPSPlus copies each term into a fixed 15 character buffer as it
+/// streams in, TinyGPSSentence takes one complete line and splits it in
+/// place: every term is a TinyGPSField pointing into the caller's buffer,
+/// with no copying and no length limit. Typed decoders then convert only the
+/// fields they need.
+
+#include "TinyGPS++.h"
+
+/// \brief One NMEA sentence split into views of its terms
+///
+/// Terms are numbered like the termNumber of TinyGPSCustom: term 0 is the
+/// address field ("GPRMC"), term 1 the first field after it, and so on. The
+/// views stay valid as long as the parsed buffer.
+class TinyGPSSentence {
+public:
+  /// Constructor for an empty sentence
+  TinyGPSSentence() : termCount(0), truncated(false), valid(false) {}
+
+  /// Split one sentence into its terms. The sentence runs from an optional
+  /// leading '$' to the first '*', line ending, '$' or end, whichever comes
+  /// first, and is followed by the checksum after the '*'.
+  /// \param begin first character of the sentence
+  /// \param end one past the last character available
+  /// \return true if the sentence has a checksum and it matches.
+  bool parse(const char *begin, const char *end);
+
+  /// Split one NUL-terminated sentence into its terms.
+  /// \param line the sentence
+  /// \return true if the sentence has a checksum and it matches.
+  bool parse(const char *line);
+
+#if defined(_GPS_HOST_BUILD) && __cplusplus >= 201703L
+  /// Split one sentence into its terms.
+  /// \param line the sentence
+  /// \return true if the sentence has a checksum and it matches.
+  bool parse(std::string_view line) {
+    return parse(line.data(), line.data() + line.size());
+  }
+#endif
+
+  /// Query if the last parse() found a matching checksum.
+  /// \return true if the checksum matched.
+  bool isValid() const { return valid; }
+
+  /// Talker ID, for example "GP". "P" for proprietary sentences.
+  /// \return view of the talker ID
+  const TinyGPSField &talker() const { return talkerField; }
+
+  /// Sentence formatter, for example "RMC". For proprietary sentences this
+  /// is the rest of the address after the "P", for example "UBX".
+  /// \return view of the formatter
+  const TinyGPSField &formatter() const { return formatterField; }
+
+  /// Checksum digits after the '*'
+  /// \return view of the checksum, empty if there is none
+  const TinyGPSField &checksum() const { return checksumField; }
+
+  /// Get a term.
+  /// \param n term number, 0 for the address field
+  /// \return view of the term, empty if the sentence has no such term.
+  const TinyGPSField &term(size_t n) const {
+    static const TinyGPSField none;
+    return n < termCount ? terms[n] : none;
+  }
+
+  /// Number of terms kept, address field included
+  /// \return count of terms
+  size_t size() const { return termCount; }
+
+  /// Query if the sentence had more than _GPS_MAX_SENTENCE_TERMS terms. The
+  /// terms past that limit are dropped, but still count for the checksum.
+  /// \return true if terms were dropped.
+  bool isTruncated() const { return truncated; }
+
+private:
+  TinyGPSField terms[_GPS_MAX_SENTENCE_TERMS];
+  TinyGPSField talkerField, formatterField, checksumField;
+  uint8_t termCount;
+  bool truncated, valid;
+};
+
+#endif // def(__TinyGPSSentence_h)
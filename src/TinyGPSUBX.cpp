@@ -0,0 +1,226 @@
+/*
+TinyGPS++ - a small GPS library for Arduino providing universal NMEA parsing
+Copyright (C) 2008-2013 Mikal Hart
+All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#include "TinyGPSUBX.h"
+
+/// \file
+/// \brief TinyGPSUBX implementation file
+
+uint8_t TinyGPSUBX::encode(uint8_t c) {
+  switch (state) {
+  case IDLE:
+    if (c != SYNC_1)
+      return NOT_UBX;
+    state = SYNC;
+    return IN_FRAME;
+
+  case SYNC:
+    if (c == SYNC_2) {
+      state = CLASS;
+      checksumA = checksumB = 0;
+      return IN_FRAME;
+    }
+    if (c == SYNC_1)
+      return IN_FRAME;
+    state = IDLE;
+    return NOT_UBX;
+
+  case CHECKSUM_A:
+    receivedA = c;
+    state = CHECKSUM_B;
+    return IN_FRAME;
+
+  case CHECKSUM_B:
+    state = IDLE;
+    return receivedA == checksumA && c == checksumB ? PASSED : FAILED;
+  }
+
+  // Everything from the class byte to the end of the payload is summed
+  checksumA += c;
+  checksumB += checksumA;
+
+  switch (state) {
+  case CLASS:
+    frameClass = c;
+    state = ID;
+    break;
+  case ID:
+    frameId = c;
+    state = LENGTH_LOW;
+    break;
+  case LENGTH_LOW:
+    length = c;
+    state = LENGTH_HIGH;
+    break;
+  case LENGTH_HIGH:
+    length |= (uint16_t)c << 8;
+    if (length > _GPS_UBX_MAX_PAYLOAD) {
+      state = IDLE;
+      return FAILED;
+    }
+    offset = 0;
+    capturing = isNavPvt();
+    state = length ? PAYLOAD : CHECKSUM_A;
+    break;
+  case PAYLOAD:
+    word = word >> 8 | (uint32_t)c << 24;
+    if (capturing)
+      capture(c);
+    if (++offset == length)
+      state = CHECKSUM_A;
+    break;
+  }
+  return IN_FRAME;
+}
+
+const char *TinyGPSUBX::encode(const char *p, const char *end,
+                               uint8_t &status) {
+  status = IN_FRAME;
+  while (p < end) {
+    size_t available = (size_t)(end - p);
+    if (state == PAYLOAD &&
+        (!capturing || (offset == 0 && available >= length))) {
+      // Sum the payload in one loop, decoding a NAV-PVT payload in place
+      size_t remaining = (size_t)(length - offset);
+      size_t n = remaining < available ? remaining : available;
+      const uint8_t *payload = (const uint8_t *)p;
+      if (capturing)
+        decodeNavPvt(payload);
+      uint8_t a = checksumA, b = checksumB;
+      for (size_t i = 0; i < n; ++i) {
+        a += payload[i];
+        b += a;
+      }
+      checksumA = a;
+      checksumB = b;
+      offset += (uint16_t)n;
+      p += n;
+      if (offset == length)
+        state = CHECKSUM_A;
+      continue;
+    }
+
+    status = encode((uint8_t)*p);
+    if (status == NOT_UBX)
+      return p;
+    ++p;
+    if (status != IN_FRAME)
+      return p;
+  }
+  return p;
+}
+
+// Reads a little-endian field of a payload
+static uint32_t load(const uint8_t *p, int bytes) {
+  uint32_t value = 0;
+  for (int i = bytes - 1; i >= 0; --i)
+    value = value << 8 | p[i];
+  return value;
+}
+
+// Decodes a whole NAV-PVT payload
+void TinyGPSUBX::decodeNavPvt(const uint8_t *payload) {
+  pvt.year = (uint16_t)load(payload + PVT_YEAR, 2);
+  pvt.month = payload[PVT_MONTH];
+  pvt.day = payload[PVT_DAY];
+  pvt.hour = payload[PVT_HOUR];
+  pvt.minute = payload[PVT_MINUTE];
+  pvt.second = payload[PVT_SECOND];
+  pvt.validity = payload[PVT_VALIDITY];
+  pvt.nano = (int32_t)load(payload + PVT_NANO, 4);
+  pvt.fixType = payload[PVT_FIX_TYPE];
+  pvt.flags = payload[PVT_FLAGS];
+  pvt.satellites = payload[PVT_SATELLITES];
+  pvt.longitude = (int32_t)load(payload + PVT_LONGITUDE, 4);
+  pvt.latitude = (int32_t)load(payload + PVT_LATITUDE, 4);
+  pvt.height = (int32_t)load(payload + PVT_HEIGHT, 4);
+  pvt.heightMSL = (int32_t)load(payload + PVT_HEIGHT_MSL, 4);
+  pvt.horizontalAccuracy = load(payload + PVT_HORIZONTAL_ACCURACY, 4);
+  pvt.verticalAccuracy = load(payload + PVT_VERTICAL_ACCURACY, 4);
+  pvt.groundSpeed = (int32_t)load(payload + PVT_GROUND_SPEED, 4);
+  pvt.heading = (int32_t)load(payload + PVT_HEADING, 4);
+  pvt.pdop = (uint16_t)load(payload + PVT_PDOP, 2);
+}
+
+// Picks the NAV-PVT fields out of the payload as their last byte arrives
+void TinyGPSUBX::capture(uint8_t c) {
+  switch (offset) {
+  case PVT_YEAR + 1:
+    pvt.year = (uint16_t)(word >> 16);
+    break;
+  case PVT_MONTH:
+    pvt.month = c;
+    break;
+  case PVT_DAY:
+    pvt.day = c;
+    break;
+  case PVT_HOUR:
+    pvt.hour = c;
+    break;
+  case PVT_MINUTE:
+    pvt.minute = c;
+    break;
+  case PVT_SECOND:
+    pvt.second = c;
+    break;
+  case PVT_VALIDITY:
+    pvt.validity = c;
+    break;
+  case PVT_NANO + 3:
+    pvt.nano = (int32_t)word;
+    break;
+  case PVT_FIX_TYPE:
+    pvt.fixType = c;
+    break;
+  case PVT_FLAGS:
+    pvt.flags = c;
+    break;
+  case PVT_SATELLITES:
+    pvt.satellites = c;
+    break;
+  case PVT_LONGITUDE + 3:
+    pvt.longitude = (int32_t)word;
+    break;
+  case PVT_LATITUDE + 3:
+    pvt.latitude = (int32_t)word;
+    break;
+  case PVT_HEIGHT + 3:
+    pvt.height = (int32_t)word;
+    break;
+  case PVT_HEIGHT_MSL + 3:
+    pvt.heightMSL = (int32_t)word;
+    break;
+  case PVT_HORIZONTAL_ACCURACY + 3:
+    pvt.horizontalAccuracy = word;
+    break;
+  case PVT_VERTICAL_ACCURACY + 3:
+    pvt.verticalAccuracy = word;
+    break;
+  case PVT_GROUND_SPEED + 3:
+    pvt.groundSpeed = (int32_t)word;
+    break;
+  case PVT_HEADING + 3:
+    pvt.heading = (int32_t)word;
+    break;
+  case PVT_PDOP + 1:
+    pvt.pdop = (uint16_t)(word >> 16);
+    break;
+  }
+}
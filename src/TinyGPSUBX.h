@@ -0,0 +1,183 @@
+/*
+TinyGPS++ - a small GPS library for Arduino providing universal NMEA parsing
+Copyright (C) 2008-2013 Mikal Hart
+All rights reserved.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation; either
+version 2.1 of the License, or (at your option) any later version.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+
+#ifndef __TinyGPSUBX_h
+#define __TinyGPSUBX_h
+
+/// \file
+/// \brief Incremental decoder for u-blox UBX binary frames.
+///
+/// A UBX frame is the sync characters 0xB5 0x62, a class and an ID byte, a
+/// little-endian 16 bit payload length, the payload, and an 8 bit Fletcher
+/// checksum over everything from the class byte on. NMEA is plain ASCII and
+/// never contains 0xB5, so TinyGPSPlus can take UBX frames and NMEA
+/// sentences mixed on the same stream.
+
+#include "TinyGPSConfig.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/// \brief Byte-at-a-time UBX frame decoder
+///
+/// The payload is not buffered: the fields of interest are picked out as
+/// their last byte arrives, so the decoder needs no more memory than the
+/// values it keeps. Only NAV-PVT (class 0x01, ID 0x07) is decoded; other
+/// frames are checked and skipped.
+class TinyGPSUBX {
+public:
+  /// Result of encode()
+  enum Status {
+    NOT_UBX,  ///< the character is not part of a frame
+    IN_FRAME, ///< the character was taken by a frame in progress
+    PASSED,   ///< the character ended a frame that passed its checksum
+    FAILED    ///< the character ended a frame that failed its checksum, or
+              ///< gave a length beyond _GPS_UBX_MAX_PAYLOAD
+  };
+
+  /// First sync character, which starts every frame
+  static const uint8_t SYNC_1 = 0xB5;
+  /// Second sync character
+  static const uint8_t SYNC_2 = 0x62;
+
+  /// Bits of NavPvt::validity
+  enum { VALID_DATE = 1, VALID_TIME = 2 };
+  /// Bits of NavPvt::flags
+  enum { GNSS_FIX_OK = 1 };
+
+  /// The navigation solution of a NAV-PVT frame, in the receiver's units
+  struct NavPvt {
+    int32_t latitude, longitude;  ///< 1e-7 degrees
+    int32_t height;               ///< above the ellipsoid, millimeters
+    int32_t heightMSL;            ///< above mean sea level, millimeters
+    uint32_t horizontalAccuracy;  ///< millimeters
+    uint32_t verticalAccuracy;    ///< millimeters
+    int32_t groundSpeed;          ///< millimeters per second
+    int32_t heading;              ///< heading of motion, 1e-5 degrees
+    int32_t nano;                 ///< fraction of the second, nanoseconds,
+                                  ///< from -1e9 to 1e9
+    uint16_t year;                ///< UTC year
+    uint16_t pdop;                ///< position DOP, hundredths
+    uint8_t month, day;           ///< UTC month and day
+    uint8_t hour, minute, second; ///< UTC time of day
+    uint8_t validity;             ///< VALID_DATE and VALID_TIME bits
+    uint8_t fixType;              ///< 0 no fix, 1 dead reckoning, 2 2D,
+                                  ///< 3 3D, 4 GNSS and dead reckoning,
+                                  ///< 5 time only
+    uint8_t flags;                ///< GNSS_FIX_OK bit
+    uint8_t satellites;           ///< satellites used in the solution
+  };
+
+  /// Constructor
+  TinyGPSUBX()
+      : state(IDLE), frameClass(0), frameId(0), checksumA(0), checksumB(0),
+        receivedA(0), capturing(false), length(0), offset(0), word(0),
+        pvt() {}
+
+  /// Process one character of the stream.
+  /// \param c the character
+  /// \return a Status. NOT_UBX means the character belongs to the NMEA
+  /// stream.
+  uint8_t encode(uint8_t c);
+
+  /// Process the characters of a frame in progress, as encode(uint8_t) for
+  /// each, up to the end of the frame. A payload held whole in the buffer is
+  /// decoded straight from it.
+  /// \param p first character
+  /// \param end end of the buffer
+  /// \param status set to the status of the last character processed,
+  /// IN_FRAME if the frame continues beyond end
+  /// \return pointer past the last character taken. A character that
+  /// returned NOT_UBX is not taken.
+  const char *encode(const char *p, const char *end, uint8_t &status);
+
+  /// Query if a frame is in progress, including a first sync character
+  /// \return true if the next character goes to the frame.
+  bool inFrame() const { return state != IDLE; }
+
+  /// Class of the last frame
+  /// \return message class
+  uint8_t messageClass() const { return frameClass; }
+
+  /// ID of the last frame
+  /// \return message ID
+  uint8_t messageId() const { return frameId; }
+
+  /// Query if the last frame is a NAV-PVT solution
+  /// \return true if navPvt() holds the last frame.
+  bool isNavPvt() const {
+    return frameClass == 0x01 && frameId == 0x07 && length == NAV_PVT_LENGTH;
+  }
+
+  /// The solution of the last NAV-PVT frame. Only complete when encode()
+  /// has just returned PASSED for it: the next NAV-PVT frame overwrites it
+  /// as it arrives.
+  /// \return the solution
+  const NavPvt &navPvt() const { return pvt; }
+
+private:
+  enum {
+    IDLE,
+    SYNC,
+    CLASS,
+    ID,
+    LENGTH_LOW,
+    LENGTH_HIGH,
+    PAYLOAD,
+    CHECKSUM_A,
+    CHECKSUM_B
+  };
+  enum { NAV_PVT_LENGTH = 92 };
+  // Offsets of the NAV-PVT fields in the payload
+  enum {
+    PVT_YEAR = 4,
+    PVT_MONTH = 6,
+    PVT_DAY = 7,
+    PVT_HOUR = 8,
+    PVT_MINUTE = 9,
+    PVT_SECOND = 10,
+    PVT_VALIDITY = 11,
+    PVT_NANO = 16,
+    PVT_FIX_TYPE = 20,
+    PVT_FLAGS = 21,
+    PVT_SATELLITES = 23,
+    PVT_LONGITUDE = 24,
+    PVT_LATITUDE = 28,
+    PVT_HEIGHT = 32,
+    PVT_HEIGHT_MSL = 36,
+    PVT_HORIZONTAL_ACCURACY = 40,
+    PVT_VERTICAL_ACCURACY = 44,
+    PVT_GROUND_SPEED = 60,
+    PVT_HEADING = 64,
+    PVT_PDOP = 76
+  };
+
+  uint8_t state;
+  uint8_t frameClass, frameId;
+  uint8_t checksumA, checksumB, receivedA;
+  bool capturing;
+  uint16_t length, offset;
+  uint32_t word; // the last four payload bytes, little-endian
+  NavPvt pvt;
+
+  void capture(uint8_t c);
+  void decodeNavPvt(const uint8_t *payload);
+};
+
+#endif // def(__TinyGPSUBX_h)